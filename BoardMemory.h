@@ -0,0 +1,161 @@
+#ifndef BOARDMEMORY_H
+#define BOARDMEMORY_H
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <string>
+
+// Where a board's containers get their memory
+enum class MemoryMode
+{
+    Heap,     // Straight from the global heap, block by block
+    Pool,     // Size-class pools: freed blocks are reused by the same board
+    Monotonic // Bump allocation; nothing is returned until the board is destroyed or rebuilt
+};
+
+// Traffic through one allocation layer
+struct MemoryStats
+{
+    size_t allocations = 0;
+    size_t deallocations = 0;
+    size_t bytesInUse = 0;
+    size_t peakBytesInUse = 0;
+
+    std::string toJson() const
+    {
+        return "{\"allocations\":" + std::to_string(allocations) +
+               ",\"deallocations\":" + std::to_string(deallocations) +
+               ",\"bytesInUse\":" + std::to_string(bytesInUse) +
+               ",\"peakBytesInUse\":" + std::to_string(peakBytesInUse) + "}";
+    }
+};
+
+// Pass-through resource that counts what goes through it. Not synchronized: like
+// the containers it serves, it is only used by whoever holds the board's write lock.
+class CountingResource : public std::pmr::memory_resource
+{
+private:
+    std::pmr::memory_resource *upstream;
+    MemoryStats stats;
+
+    void *do_allocate(size_t bytes, size_t alignment) override
+    {
+        void *p = upstream->allocate(bytes, alignment);
+        ++stats.allocations;
+        stats.bytesInUse += bytes;
+        if (stats.bytesInUse > stats.peakBytesInUse)
+            stats.peakBytesInUse = stats.bytesInUse;
+        return p;
+    }
+
+    void do_deallocate(void *p, size_t bytes, size_t alignment) override
+    {
+        upstream->deallocate(p, bytes, alignment);
+        ++stats.deallocations;
+        stats.bytesInUse -= bytes;
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+    {
+        return this == &other;
+    }
+
+public:
+    explicit CountingResource(std::pmr::memory_resource *upstream) : upstream(upstream) {}
+
+    const MemoryStats &getStats() const { return stats; }
+};
+
+// Memory use of one board: what its containers asked for, and what the
+// allocation strategy took from the heap to serve that
+struct BoardMemoryStats
+{
+    MemoryMode mode;
+    MemoryStats requested;
+    MemoryStats reserved;
+
+    std::string toJson() const;
+};
+
+// The resource stack behind one TaskManager. Containers allocate from
+// 'requested', which feeds the chosen strategy, which takes its blocks from the
+// heap through 'reserved'. In Pool and Monotonic mode a board's nodes sit
+// together in a few large blocks instead of being spread over the global heap,
+// and destroying the board hands those blocks back in one go.
+class BoardMemory
+{
+private:
+    MemoryMode mode;
+    CountingResource reserved;
+    std::unique_ptr<std::pmr::memory_resource> strategy; // Null in Heap mode
+    CountingResource requested;
+
+    static std::unique_ptr<std::pmr::memory_resource> makeStrategy(MemoryMode mode, std::pmr::memory_resource *upstream)
+    {
+        switch (mode)
+        {
+        case MemoryMode::Pool:
+            return std::make_unique<std::pmr::unsynchronized_pool_resource>(upstream);
+        case MemoryMode::Monotonic:
+            return std::make_unique<std::pmr::monotonic_buffer_resource>(upstream);
+        default:
+            return nullptr;
+        }
+    }
+
+public:
+    explicit BoardMemory(MemoryMode mode = MemoryMode::Heap)
+        : mode(mode),
+          reserved(std::pmr::new_delete_resource()),
+          strategy(makeStrategy(mode, &reserved)),
+          requested(strategy ? strategy.get() : &reserved)
+    {
+    }
+
+    BoardMemory(const BoardMemory &) = delete;
+    BoardMemory &operator=(const BoardMemory &) = delete;
+
+    std::pmr::memory_resource *resource() { return &requested; }
+
+    BoardMemoryStats getStats() const
+    {
+        return {mode, requested.getStats(), reserved.getStats()};
+    }
+
+    static const char *modeName(MemoryMode mode)
+    {
+        switch (mode)
+        {
+        case MemoryMode::Pool:
+            return "pool";
+        case MemoryMode::Monotonic:
+            return "monotonic";
+        default:
+            return "heap";
+        }
+    }
+
+    // Parse "heap", "pool" or "monotonic"
+    static bool parseMode(const std::string &name, MemoryMode &mode)
+    {
+        for (MemoryMode candidate : {MemoryMode::Heap, MemoryMode::Pool, MemoryMode::Monotonic})
+        {
+            if (name == modeName(candidate))
+            {
+                mode = candidate;
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+inline std::string BoardMemoryStats::toJson() const
+{
+    return std::string("{\"mode\":\"") + BoardMemory::modeName(mode) +
+           "\",\"requested\":" + requested.toJson() +
+           ",\"reserved\":" + reserved.toJson() + "}";
+}
+
+#endif // BOARDMEMORY_H
@@ -0,0 +1,123 @@
+#ifndef BOARDREGISTRY_H
+#define BOARDREGISTRY_H
+
+#include <array>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "SharedTaskManager.h"
+
+// Named task boards (one per team), each its own SharedTaskManager with its own
+// lock and storage, so work on one board never waits on another.
+//
+// Board names are hash-partitioned over SHARD_COUNT shards. A shard lock only
+// guards its name -> board map and is held just long enough to look up or create
+// a board, never while the board itself is in use. Boards are never removed, so
+// references handed out stay valid for the registry's lifetime.
+class BoardRegistry
+{
+public:
+    static constexpr size_t SHARD_COUNT = 64;
+    static constexpr size_t MAX_BOARDS = 4096;
+    static constexpr size_t MAX_NAME_LENGTH = 64;
+
+private:
+    // Padded to a cache line so neighbouring shard locks do not false-share
+    struct alignas(64) Shard
+    {
+        mutable std::shared_mutex mutex;
+        std::unordered_map<std::string, std::unique_ptr<SharedTaskManager>> boards;
+    };
+
+    std::array<Shard, SHARD_COUNT> shards;
+    std::atomic<size_t> boardCount{0};
+    const MemoryMode boardMemory; // Allocation strategy of every board created here
+
+    Shard &shardFor(const std::string &name)
+    {
+        return shards[std::hash<std::string>{}(name) % SHARD_COUNT];
+    }
+
+    const Shard &shardFor(const std::string &name) const
+    {
+        return shards[std::hash<std::string>{}(name) % SHARD_COUNT];
+    }
+
+public:
+    explicit BoardRegistry(MemoryMode boardMemory = MemoryMode::Heap) : boardMemory(boardMemory) {}
+
+    // Names are 1-64 characters of [A-Za-z0-9_-] so they can appear in URLs unescaped
+    static bool isValidName(const std::string &name)
+    {
+        if (name.empty() || name.size() > MAX_NAME_LENGTH)
+            return false;
+
+        for (char c : name)
+        {
+            bool ok = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '-' || c == '_';
+            if (!ok)
+                return false;
+        }
+        return true;
+    }
+
+    // Existing board, or nullptr
+    SharedTaskManager *findBoard(const std::string &name) const
+    {
+        const Shard &shard = shardFor(name);
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        auto it = shard.boards.find(name);
+        return it == shard.boards.end() ? nullptr : it->second.get();
+    }
+
+    // Board with this name, created on first use; nullptr if the name is invalid
+    // or the registry is full
+    SharedTaskManager *getOrCreateBoard(const std::string &name)
+    {
+        if (SharedTaskManager *existing = findBoard(name))
+            return existing;
+        if (!isValidName(name))
+            return nullptr;
+
+        Shard &shard = shardFor(name);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        auto it = shard.boards.find(name);
+        if (it != shard.boards.end())
+            return it->second.get();
+
+        if (boardCount.fetch_add(1) >= MAX_BOARDS)
+        {
+            boardCount.fetch_sub(1);
+            return nullptr;
+        }
+        auto inserted = shard.boards.emplace(name, std::make_unique<SharedTaskManager>(boardMemory));
+        return inserted.first->second.get();
+    }
+
+    size_t getBoardCount() const
+    {
+        return boardCount.load();
+    }
+
+    // Names of every board, in no particular order
+    std::vector<std::string> getBoardNames() const
+    {
+        std::vector<std::string> names;
+        for (const Shard &shard : shards)
+        {
+            std::shared_lock<std::shared_mutex> lock(shard.mutex);
+            for (const auto &entry : shard.boards)
+            {
+                names.push_back(entry.first);
+            }
+        }
+        return names;
+    }
+};
+
+#endif // BOARDREGISTRY_H
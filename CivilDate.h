@@ -0,0 +1,133 @@
+#ifndef CIVILDATE_H
+#define CIVILDATE_H
+
+#include <cstdint>
+#include <cstddef>
+#include <chrono>
+
+// Calendar dates stored as a day count since 1970-01-01 (proleptic Gregorian,
+// no time zone). Conversions use Howard Hinnant's days_from_civil /
+// civil_from_days algorithms: pure integer arithmetic, constexpr, no locale,
+// no std::tm, and therefore safe to call from any thread.
+
+constexpr std::int64_t SECONDS_PER_DAY = 86400;
+
+// Day number of a (year, month 1-12, day 1-31) date
+constexpr std::int32_t daysFromCivil(int y, unsigned m, unsigned d)
+{
+    y -= m <= 2;
+    const int era = (y >= 0 ? y : y - 399) / 400;
+    const unsigned yoe = static_cast<unsigned>(y - era * 400);
+    const unsigned doy = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1;
+    const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return static_cast<std::int32_t>(era * 146097 + static_cast<int>(doe) - 719468);
+}
+
+// (year, month, day) of a day number
+constexpr void civilFromDays(std::int32_t z, int &y, unsigned &m, unsigned &d)
+{
+    z += 719468;
+    const int era = (z >= 0 ? z : z - 146096) / 146097;
+    const unsigned doe = static_cast<unsigned>(z - era * 146097);
+    const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    const unsigned mp = (5 * doy + 2) / 153;
+    d = doy - (153 * mp + 2) / 5 + 1;
+    m = mp < 10 ? mp + 3 : mp - 9;
+    y = static_cast<int>(yoe) + era * 400 + (m <= 2);
+}
+
+// Length of a formatted date, without terminator
+constexpr std::size_t ISO_DATE_LENGTH = 10;
+
+// Write "YYYY-MM-DD" into out (at least ISO_DATE_LENGTH chars, not terminated).
+// Years outside 0000-9999 are clamped to the nearest representable date.
+constexpr void formatIsoDate(std::int32_t days, char *out)
+{
+    int y = 0;
+    unsigned m = 0, d = 0;
+    civilFromDays(days, y, m, d);
+    if (y < 0)
+    {
+        y = 0, m = 1, d = 1;
+    }
+    else if (y > 9999)
+    {
+        y = 9999, m = 12, d = 31;
+    }
+
+    const unsigned year = static_cast<unsigned>(y);
+    out[0] = static_cast<char>('0' + year / 1000);
+    out[1] = static_cast<char>('0' + year / 100 % 10);
+    out[2] = static_cast<char>('0' + year / 10 % 10);
+    out[3] = static_cast<char>('0' + year % 10);
+    out[4] = '-';
+    out[5] = static_cast<char>('0' + m / 10);
+    out[6] = static_cast<char>('0' + m % 10);
+    out[7] = '-';
+    out[8] = static_cast<char>('0' + d / 10);
+    out[9] = static_cast<char>('0' + d % 10);
+}
+
+// Parse exactly "YYYY-MM-DD"; returns false (leaving days untouched) on malformed
+// input or an impossible calendar date such as 2025-02-30
+constexpr bool parseIsoDate(const char *s, std::size_t len, std::int32_t &days)
+{
+    if (len != ISO_DATE_LENGTH || s[4] != '-' || s[7] != '-')
+        return false;
+
+    // Accumulate a bit for every character that is not a digit instead of branching per digit
+    unsigned bad = 0;
+    unsigned v[8] = {};
+    const std::size_t digitPos[8] = {0, 1, 2, 3, 5, 6, 8, 9};
+    for (std::size_t i = 0; i < 8; ++i)
+    {
+        v[i] = static_cast<unsigned>(static_cast<unsigned char>(s[digitPos[i]]) - '0');
+        bad |= v[i] > 9;
+    }
+    if (bad)
+        return false;
+
+    const int y = static_cast<int>(v[0] * 1000 + v[1] * 100 + v[2] * 10 + v[3]);
+    const unsigned m = v[4] * 10 + v[5];
+    const unsigned d = v[6] * 10 + v[7];
+    if (m < 1 || m > 12 || d < 1)
+        return false;
+
+    const bool leap = (y % 4 == 0 && y % 100 != 0) || y % 400 == 0;
+    const unsigned monthDays[12] = {31, leap ? 29u : 28u, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    if (d > monthDays[m - 1])
+        return false;
+
+    days = daysFromCivil(y, m, d);
+    return true;
+}
+
+// Day containing a time point (UTC), rounding towards the past
+inline std::int32_t daysFromTimePoint(const std::chrono::system_clock::time_point &tp)
+{
+    std::int64_t secs = std::chrono::floor<std::chrono::seconds>(tp.time_since_epoch()).count();
+    std::int64_t days = secs / SECONDS_PER_DAY;
+    if (secs % SECONDS_PER_DAY < 0)
+        --days;
+    return static_cast<std::int32_t>(days);
+}
+
+// Midnight (UTC) at the start of a day
+inline std::chrono::system_clock::time_point timePointFromDays(std::int32_t days)
+{
+    return std::chrono::system_clock::time_point(
+        std::chrono::duration_cast<std::chrono::system_clock::duration>(
+            std::chrono::seconds(static_cast<std::int64_t>(days) * SECONDS_PER_DAY)));
+}
+
+// First day whose start is at or after a time point
+inline std::int32_t daysCeilFromTimePoint(const std::chrono::system_clock::time_point &tp)
+{
+    std::int32_t days = daysFromTimePoint(tp);
+    if (timePointFromDays(days) < tp)
+        ++days;
+    return days;
+}
+
+#endif // CIVILDATE_H
@@ -0,0 +1,165 @@
+#ifndef COMPACTTASK_H
+#define COMPACTTASK_H
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Task.h"
+#include "StringPool.h"
+
+// Task packed into 24 bytes: the strings live in a StringArena shared by every
+// record and are referred to by offset. A Task with its two std::strings takes
+// 88 bytes before counting the strings' heap blocks.
+struct CompactTask
+{
+    static constexpr std::uint8_t COMPLETED = 1; // Bit in 'flags'
+
+    TaskId id;
+    StringArena::Ref title;
+    StringArena::Ref description;
+    std::int32_t dueDay; // Days since 1970-01-01
+    std::int8_t priority;
+    std::uint8_t flags;
+
+    bool isCompleted() const { return flags & COMPLETED; }
+};
+
+static_assert(sizeof(CompactTask) == 24, "CompactTask should stay three words");
+
+// Memory taken by a set of tasks, split into fixed-size records and string data
+struct TaskMemoryReport
+{
+    size_t taskCount = 0;
+    size_t recordBytes = 0;
+    size_t stringBytes = 0;
+
+    size_t totalBytes() const { return recordBytes + stringBytes; }
+
+    double bytesPerTask() const
+    {
+        return taskCount ? static_cast<double>(totalBytes()) / static_cast<double>(taskCount) : 0.0;
+    }
+
+    std::string toJson() const
+    {
+        return "{\"tasks\":" + std::to_string(taskCount) +
+               ",\"recordBytes\":" + std::to_string(recordBytes) +
+               ",\"stringBytes\":" + std::to_string(stringBytes) +
+               ",\"bytesPerTask\":" + std::to_string(bytesPerTask()) + "}";
+    }
+};
+
+// Dense array of CompactTask records plus the pool holding their strings, for
+// holding very large numbers of tasks in little memory. The live boards do not
+// use it: a TaskManager keeps full Tasks, and the ID map and snapshots share
+// one immutable copy of each. task_bench --memory compares the footprints.
+// Titles are interned by default, so records with the same title share one
+// copy and compare equal by Ref; descriptions are appended as-is.
+class CompactTaskStore
+{
+private:
+    std::vector<CompactTask> records;
+    StringPool strings;
+    bool internTitles;
+
+public:
+    explicit CompactTaskStore(bool internTitles = true) : internTitles(internTitles) {}
+
+    // Priorities outside the 8-bit range are rejected rather than stored wrong
+    static std::int8_t packPriority(int priority)
+    {
+        if (priority < INT8_MIN || priority > INT8_MAX)
+            throw std::out_of_range("task priority does not fit in a compact record");
+        return static_cast<std::int8_t>(priority);
+    }
+
+    void reserve(size_t taskCount)
+    {
+        records.reserve(taskCount);
+    }
+
+    // Append a copy of 'task'; returns its index
+    size_t add(const Task &task)
+    {
+        CompactTask record;
+        record.id = task.getId();
+        record.title = internTitles ? strings.intern(task.getTitle()) : strings.store(task.getTitle());
+        record.description = strings.store(task.getDescription());
+        record.dueDay = task.getDueDay();
+        record.priority = packPriority(task.getPriority());
+        record.flags = task.isCompleted() ? CompactTask::COMPLETED : 0;
+        records.push_back(record);
+        return records.size() - 1;
+    }
+
+    size_t size() const { return records.size(); }
+    bool empty() const { return records.empty(); }
+
+    const CompactTask &operator[](size_t i) const { return records[i]; }
+
+    std::string_view getTitle(size_t i) const { return strings.view(records[i].title); }
+    std::string_view getDescription(size_t i) const { return strings.view(records[i].description); }
+
+    // Indexes of the records with this title, in insertion order
+    std::vector<size_t> findByTitle(std::string_view title) const
+    {
+        std::vector<size_t> matches;
+        if (internTitles)
+        {
+            StringPool::Ref ref;
+            if (!strings.find(title, ref))
+                return matches;
+            for (size_t i = 0; i < records.size(); ++i)
+            {
+                if (records[i].title == ref)
+                    matches.push_back(i);
+            }
+            return matches;
+        }
+
+        for (size_t i = 0; i < records.size(); ++i)
+        {
+            if (strings.view(records[i].title) == title)
+                matches.push_back(i);
+        }
+        return matches;
+    }
+
+    void setCompleted(size_t i, bool completed)
+    {
+        if (completed)
+            records[i].flags |= CompactTask::COMPLETED;
+        else
+            records[i].flags &= static_cast<std::uint8_t>(~CompactTask::COMPLETED);
+    }
+
+    // Expand record i back into a full Task with the same ID
+    Task toTask(size_t i) const
+    {
+        const CompactTask &record = records[i];
+        return Task::restore(record.id, std::string(strings.view(record.title)), std::string(strings.view(record.description)),
+                             record.dueDay, record.priority, record.isCompleted());
+    }
+
+    // Drop every task, releasing the records and the whole arena in one step each
+    void clear()
+    {
+        records.clear();
+        records.shrink_to_fit();
+        strings.clear();
+    }
+
+    // Bytes held, counting reserved capacity
+    TaskMemoryReport memoryReport() const
+    {
+        TaskMemoryReport report;
+        report.taskCount = records.size();
+        report.recordBytes = records.capacity() * sizeof(CompactTask);
+        report.stringBytes = strings.bytesReserved(); // Including the intern table
+        return report;
+    }
+};
+
+#endif // COMPACTTASK_H
@@ -0,0 +1,193 @@
+#ifndef CONCURRENTTASKMAP_H
+#define CONCURRENTTASKMAP_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include "EpochReclaimer.h"
+#include "Task.h"
+
+// Open-addressing ID -> Task map for one writer and any number of lock-free
+// readers.
+//
+// Every value is an immutable heap copy of a task, shared with other holders
+// such as board snapshots. The writer replaces a copy by swapping the pointer
+// and retiring its reference to the old one; removal swaps in nullptr and
+// leaves the key as a tombstone (IDs are never reused, so tombstones are only
+// dropped when the table is rebuilt). Growing builds a new table and swaps the
+// table pointer. Readers pin an epoch for the probe, so neither old copies nor
+// old tables are freed under them.
+//
+// The writer side (store, remove) must be serialized externally.
+class ConcurrentTaskMap
+{
+private:
+    static constexpr TaskId EMPTY = 0; // Task IDs start at 1
+
+    struct Slot
+    {
+        std::atomic<TaskId> key{EMPTY};
+        std::atomic<const Task *> value{nullptr}; // nullptr once removed
+        std::shared_ptr<const Task> owner;        // Writer only: keeps 'value' alive
+    };
+
+    struct Table
+    {
+        size_t mask;
+        std::unique_ptr<Slot[]> slots;
+        size_t usedSlots = 0; // Keys including tombstones (writer only)
+
+        explicit Table(size_t capacity) : mask(capacity - 1), slots(new Slot[capacity]) {}
+
+        size_t capacity() const { return mask + 1; }
+
+        // Fibonacci hashing spreads sequential IDs across the table
+        size_t home(TaskId id) const
+        {
+            return static_cast<size_t>((id * 0x9E3779B97F4A7C15ull) >> 32) & mask;
+        }
+
+        // Slot holding 'id', or nullptr if it has never been stored
+        Slot *find(TaskId id) const
+        {
+            for (size_t i = home(id), probes = 0; probes <= mask; i = (i + 1) & mask, ++probes)
+            {
+                TaskId key = slots[i].key.load(std::memory_order_acquire);
+                if (key == id)
+                    return &slots[i];
+                if (key == EMPTY)
+                    return nullptr;
+            }
+            return nullptr;
+        }
+    };
+
+    static constexpr size_t MIN_CAPACITY = 16;
+
+    std::atomic<Table *> table;
+    size_t liveCount = 0; // Writer only
+    EpochReclaimer::RetireList retired;
+
+    // Swap a slot's copy for 'task' (nullptr to remove it). Readers may still
+    // hold the old copy, so the map's reference to it is dropped only once they are done.
+    void replaceValue(Slot &slot, std::shared_ptr<const Task> task)
+    {
+        const Task *old = slot.value.exchange(task.get(), std::memory_order_acq_rel);
+        if (old)
+            retired.retire(new std::shared_ptr<const Task>(std::move(slot.owner)));
+        if (!old && task)
+            ++liveCount;
+        else if (old && !task)
+            --liveCount;
+        slot.owner = std::move(task);
+    }
+
+    // Rebuild into a table sized for the live entries, dropping tombstones
+    void rebuild()
+    {
+        Table *old = table.load(std::memory_order_relaxed);
+        size_t capacity = MIN_CAPACITY;
+        while (capacity < (liveCount + 1) * 4)
+            capacity *= 2;
+
+        Table *next = new Table(capacity);
+        for (size_t i = 0; i <= old->mask; ++i)
+        {
+            const Task *value = old->slots[i].value.load(std::memory_order_relaxed);
+            if (!value)
+                continue;
+
+            TaskId id = old->slots[i].key.load(std::memory_order_relaxed);
+            size_t j = next->home(id);
+            while (next->slots[j].key.load(std::memory_order_relaxed) != EMPTY)
+                j = (j + 1) & next->mask;
+            next->slots[j].value.store(value, std::memory_order_relaxed);
+            next->slots[j].owner = std::move(old->slots[i].owner);
+            next->slots[j].key.store(id, std::memory_order_relaxed);
+            ++next->usedSlots;
+        }
+
+        table.store(next, std::memory_order_release);
+        retired.retire(old); // Only the table; the task copies moved over
+    }
+
+public:
+    ConcurrentTaskMap() : table(new Table(MIN_CAPACITY)) {}
+
+    ConcurrentTaskMap(const ConcurrentTaskMap &) = delete;
+    ConcurrentTaskMap &operator=(const ConcurrentTaskMap &) = delete;
+
+    // Requires that no reader is still running
+    ~ConcurrentTaskMap()
+    {
+        delete table.load();
+    }
+
+    // Call 'visit' with the current copy of task 'id'; returns false if there is none.
+    // Takes no lock and never waits for the writer.
+    template <typename Visitor>
+    bool read(TaskId id, Visitor visit) const
+    {
+        EpochReclaimer::ReadGuard guard;
+        Slot *slot = table.load(std::memory_order_acquire)->find(id);
+        const Task *task = slot ? slot->value.load(std::memory_order_acquire) : nullptr;
+        if (!task)
+            return false;
+
+        visit(*task);
+        return true;
+    }
+
+    std::optional<Task> find(TaskId id) const
+    {
+        std::optional<Task> copy;
+        read(id, [&copy](const Task &task)
+             { copy = task; });
+        return copy;
+    }
+
+    // Writer: insert or replace the copy of task->getId()
+    void store(std::shared_ptr<const Task> task)
+    {
+        TaskId id = task->getId();
+        const Task *copy = task.get();
+
+        Table *current = table.load(std::memory_order_relaxed);
+        if (Slot *slot = current->find(id))
+        {
+            replaceValue(*slot, std::move(task));
+            return;
+        }
+
+        // Keep the load factor (tombstones included) at or below one half
+        if ((current->usedSlots + 1) * 2 > current->capacity())
+        {
+            rebuild();
+            current = table.load(std::memory_order_relaxed);
+        }
+
+        size_t i = current->home(id);
+        while (current->slots[i].key.load(std::memory_order_relaxed) != EMPTY)
+            i = (i + 1) & current->mask;
+
+        // Value first, so a reader that sees the key also sees the task
+        current->slots[i].owner = std::move(task);
+        current->slots[i].value.store(copy, std::memory_order_relaxed);
+        current->slots[i].key.store(id, std::memory_order_release);
+        ++current->usedSlots;
+        ++liveCount;
+    }
+
+    // Writer: drop task 'id'
+    void remove(TaskId id)
+    {
+        if (Slot *slot = table.load(std::memory_order_relaxed)->find(id))
+            replaceValue(*slot, nullptr);
+    }
+
+    // Writer-side count of live entries
+    size_t size() const { return liveCount; }
+};
+
+#endif // CONCURRENTTASKMAP_H
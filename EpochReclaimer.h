@@ -0,0 +1,200 @@
+#ifndef EPOCHRECLAIMER_H
+#define EPOCHRECLAIMER_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Epoch-based reclamation for structures whose readers take no locks.
+//
+// A reader pins the current global epoch for the duration of a read (ReadGuard).
+// A writer that unlinks an object retires it, tagged with the epoch at that
+// moment, and frees it once the global epoch is two ahead: the epoch can only
+// advance when every pinned reader has caught up with it, so by then no reader
+// that might still hold the pointer remains.
+//
+// Reader slots are shared process-wide (one per thread, claimed on first use and
+// released when the thread exits); each writer keeps its own RetireList, guarded
+// by whatever already serializes that writer.
+class EpochReclaimer
+{
+public:
+    static constexpr size_t MAX_THREADS = 1024;
+
+private:
+    static constexpr std::uint64_t IDLE = UINT64_MAX;
+
+    struct alignas(64) ReaderSlot
+    {
+        std::atomic<std::uint64_t> epoch{IDLE};
+        std::atomic<bool> claimed{false};
+    };
+
+    std::atomic<std::uint64_t> globalEpoch{0};
+    std::array<ReaderSlot, MAX_THREADS> slots;
+
+    // This thread's slot and nesting depth; the slot is handed back on thread exit
+    struct ThreadState
+    {
+        ReaderSlot *slot = nullptr;
+        unsigned depth = 0;
+
+        ~ThreadState()
+        {
+            if (slot)
+                slot->claimed.store(false, std::memory_order_release);
+        }
+    };
+
+    static ThreadState &threadState()
+    {
+        static thread_local ThreadState state;
+        return state;
+    }
+
+    ReaderSlot &claimSlot()
+    {
+        for (;;)
+        {
+            for (ReaderSlot &slot : slots)
+            {
+                bool expected = false;
+                if (!slot.claimed.load(std::memory_order_relaxed) &&
+                    slot.claimed.compare_exchange_strong(expected, true, std::memory_order_acquire))
+                    return slot;
+            }
+            std::this_thread::yield(); // More live reader threads than slots; wait for one to exit
+        }
+    }
+
+    void pin()
+    {
+        ThreadState &state = threadState();
+        if (state.depth++ > 0)
+            return;
+        if (!state.slot)
+            state.slot = &claimSlot();
+
+        // Publish the epoch, then confirm it did not move before the slot became visible
+        std::uint64_t epoch = globalEpoch.load();
+        for (;;)
+        {
+            state.slot->epoch.store(epoch);
+            std::uint64_t current = globalEpoch.load();
+            if (current == epoch)
+                return;
+            epoch = current;
+        }
+    }
+
+    void unpin()
+    {
+        ThreadState &state = threadState();
+        if (--state.depth == 0)
+            state.slot->epoch.store(IDLE, std::memory_order_release);
+    }
+
+    // Move the global epoch forward if every pinned reader has reached it
+    void tryAdvance()
+    {
+        std::uint64_t epoch = globalEpoch.load();
+        for (const ReaderSlot &slot : slots)
+        {
+            std::uint64_t pinned = slot.epoch.load();
+            if (pinned != IDLE && pinned != epoch)
+                return;
+        }
+        globalEpoch.compare_exchange_strong(epoch, epoch + 1);
+    }
+
+public:
+    static EpochReclaimer &instance()
+    {
+        static EpochReclaimer reclaimer;
+        return reclaimer;
+    }
+
+    // Keeps everything reachable at construction alive until destruction; nests
+    class ReadGuard
+    {
+    public:
+        ReadGuard() { instance().pin(); }
+        ~ReadGuard() { instance().unpin(); }
+
+        ReadGuard(const ReadGuard &) = delete;
+        ReadGuard &operator=(const ReadGuard &) = delete;
+    };
+
+    // Objects one writer has unlinked but readers may still be using
+    class RetireList
+    {
+    public:
+        static constexpr size_t RECLAIM_THRESHOLD = 64;
+
+    private:
+        struct Retired
+        {
+            std::uint64_t epoch;
+            void *object;
+            void (*destroy)(void *);
+        };
+
+        std::vector<Retired> retired;
+        size_t nextReclaim = RECLAIM_THRESHOLD; // Size at which to try again
+
+    public:
+        RetireList() = default;
+        RetireList(const RetireList &) = delete;
+        RetireList &operator=(const RetireList &) = delete;
+
+        // Only safe once no reader can be running
+        ~RetireList()
+        {
+            for (Retired &entry : retired)
+            {
+                entry.destroy(entry.object);
+            }
+        }
+
+        template <typename T>
+        void retire(T *object)
+        {
+            if (!object)
+                return;
+
+            void *erased = const_cast<void *>(static_cast<const void *>(object));
+            retired.push_back({instance().globalEpoch.load(), erased, [](void *p)
+                               { delete static_cast<T *>(p); }});
+            if (retired.size() >= nextReclaim)
+            {
+                reclaim();
+                nextReclaim = retired.size() + RECLAIM_THRESHOLD;
+            }
+        }
+
+        // Free whatever no reader can still see
+        void reclaim()
+        {
+            EpochReclaimer &reclaimer = instance();
+            reclaimer.tryAdvance();
+            std::uint64_t epoch = reclaimer.globalEpoch.load();
+
+            size_t kept = 0;
+            for (Retired &entry : retired)
+            {
+                if (entry.epoch + 2 <= epoch)
+                    entry.destroy(entry.object);
+                else
+                    retired[kept++] = entry;
+            }
+            retired.resize(kept);
+        }
+
+        size_t size() const { return retired.size(); }
+    };
+};
+
+#endif // EPOCHRECLAIMER_H
@@ -0,0 +1,532 @@
+#ifndef EPOLLREACTOR_H
+#define EPOLLREACTOR_H
+
+#ifdef __linux__
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <iostream>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "HttpMessage.h"
+#include "HttpRequestParser.h"
+#include "WorkerPool.h"
+
+// Event-driven alternative to one thread per connection (Linux only). N event
+// loops, each with its own epoll instance, share the non-blocking listening
+// socket; EPOLLEXCLUSIVE wakes one loop per burst of new connections. Client
+// sockets are non-blocking and edge-triggered, and each is a small state
+// machine: read until a whole request has arrived, hand it to the handler,
+// write the response as fast as the socket takes it, then either close or go
+// back to reading. The thread count stays at N however many connections are
+// open; a connection costs its buffers.
+//
+// Each connection reads straight into its own HttpRequestParser, and the handler
+// gets the parsed request as views into that buffer. Connections are kept alive
+// per the KeepAlivePolicy. Pipelined requests are answered in the order they
+// arrived: a loop serves what is buffered one request at a time. Each loop keeps its connections in least-recently-active order and
+// closes those idle longer than the policy's timeout.
+//
+// Given a WorkerPool, a loop only does I/O: complete requests are handed to the
+// pool, and the worker passes the response back through the loop's completion
+// list and eventfd. Requests the pool refuses are answered 503 at once.
+class EpollReactor
+{
+public:
+    // Turns one complete request into a complete response
+    using Handler = std::function<std::string(const HttpRequest &request)>;
+
+    static constexpr int MAX_EVENTS = 256;         // Events taken per epoll_wait
+    static constexpr size_t READ_CHUNK = 16384;    // Bytes read per recv
+    static constexpr int SWEEP_INTERVAL_MS = 1000; // How often idle connections are looked for
+
+private:
+    struct Connection
+    {
+        enum class State
+        {
+            Reading,
+            Processing, // With a worker, which reads the request from the parser's buffer;
+                        // events are ignored until the response is back
+            Writing
+        };
+
+        int fd;
+        State state = State::Reading;
+        bool peerClosed = false;      // Read side hit EOF
+        bool closeAfterWrite = false; // The response being written is the last
+        bool drained = false;         // The last read got everything the socket had
+        size_t requestCount = 0;
+        HttpRequestParser parser; // Buffer may hold several pipelined requests
+        std::string output;
+        size_t written = 0;
+
+        std::chrono::steady_clock::time_point lastActive;
+        bool tracked = false; // In the loop's idle list; not while Processing
+        std::list<Connection *>::iterator idlePosition;
+    };
+
+    // A response a worker has finished, and whether the connection stays open after it
+    struct Finished
+    {
+        Connection *connection;
+        std::string response;
+        bool keepOpen;
+    };
+
+    // One event loop: its epoll set, its connections, and the responses workers have finished
+    struct Loop
+    {
+        int epollFd = -1;
+        int wakeFd = -1; // eventfd a worker bumps after adding to 'finished'
+        std::unordered_map<int, std::unique_ptr<Connection>> connections;
+        std::list<Connection *> idle; // Least recently active first
+
+        std::mutex finishedMutex;
+        std::vector<Finished> finished;
+
+        ~Loop()
+        {
+            for (auto &entry : connections)
+                close(entry.first);
+            if (wakeFd >= 0)
+                close(wakeFd);
+            if (epollFd >= 0)
+                close(epollFd);
+        }
+
+        // Called on a worker thread
+        void finish(Connection *connection, std::string response, bool keepOpen)
+        {
+            {
+                std::lock_guard<std::mutex> lock(finishedMutex);
+                finished.push_back({connection, std::move(response), keepOpen});
+            }
+            std::uint64_t one = 1;
+            ssize_t written = write(wakeFd, &one, sizeof(one));
+            (void)written; // The counter cannot overflow in practice, and any non-zero value wakes the loop
+        }
+    };
+
+    int listenSocket;
+    size_t loopCount;
+    Handler handler;
+    WorkerPool *pool;
+    KeepAlivePolicy keepAlive;
+    std::vector<std::unique_ptr<Loop>> loops; // Owned here so workers can post responses back to them
+
+    // Read what the socket has straight into the parser's buffer, stopping early
+    // once more than a maximum-size request is buffered; false on a read error
+    static bool readAvailable(Connection &connection)
+    {
+        HttpRequestParser &parser = connection.parser;
+        connection.drained = false;
+        while (parser.buffered() <= parser.maxMessageSize())
+        {
+            char *space = parser.prepare(READ_CHUNK);
+            ssize_t n = recv(connection.fd, space, parser.writable(), 0);
+            if (n > 0)
+            {
+                parser.commit(static_cast<size_t>(n));
+            }
+            else if (n == 0)
+            {
+                connection.peerClosed = true;
+                connection.drained = true;
+                return true;
+            }
+            else if (errno == EAGAIN || errno == EWOULDBLOCK)
+            {
+                connection.drained = true;
+                return true;
+            }
+            else if (errno != EINTR)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Write as much of the output as the socket takes; false if the write failed
+    static bool writeAvailable(Connection &connection)
+    {
+        while (connection.written < connection.output.size())
+        {
+            ssize_t n = send(connection.fd, connection.output.data() + connection.written,
+                             connection.output.size() - connection.written, MSG_NOSIGNAL);
+            if (n >= 0)
+                connection.written += static_cast<size_t>(n);
+            else if (errno == EAGAIN || errno == EWOULDBLOCK)
+                return true;
+            else if (errno != EINTR)
+                return false;
+        }
+        return true;
+    }
+
+    std::string respond(const HttpRequest &request)
+    {
+        try
+        {
+            return handler(request);
+        }
+        catch (const std::exception &e)
+        {
+            std::cerr << "Request failed: " << e.what() << std::endl;
+            return HttpMessage::errorResponse(500);
+        }
+    }
+
+    // Handle one request and add its Connection header; 'keepOpen' says whether
+    // the connection survives it. Runs on the loop thread or a worker.
+    std::string serve(const HttpRequest &request, bool keepAliveAllowed, size_t requestsLeft, bool &keepOpen)
+    {
+        std::string response = respond(request);
+        keepOpen = HttpMessage::finishResponse(response, keepAliveAllowed, keepAlive, requestsLeft);
+        return response;
+    }
+
+    void serveOnWorker(Loop &loop, Connection *connection, bool keepAliveAllowed, size_t requestsLeft)
+    {
+        bool keepOpen;
+        std::string response = serve(connection->parser.request(), keepAliveAllowed, requestsLeft, keepOpen);
+        loop.finish(connection, std::move(response), keepOpen);
+    }
+
+    // Move a connection to the back of its loop's idle list
+    static void touch(Loop &loop, Connection &connection)
+    {
+        if (connection.tracked)
+            loop.idle.erase(connection.idlePosition);
+        connection.idlePosition = loop.idle.insert(loop.idle.end(), &connection);
+        connection.tracked = true;
+        connection.lastActive = std::chrono::steady_clock::now();
+    }
+
+    static void untrack(Loop &loop, Connection &connection)
+    {
+        if (connection.tracked)
+            loop.idle.erase(connection.idlePosition);
+        connection.tracked = false;
+    }
+
+    // Answer the complete requests in the parser's buffer, oldest first. Without
+    // a pool they are all handled here and their responses queued for writing
+    // together; with one, the first goes to a worker and the rest wait in the
+    // buffer until its response is written. False when the connection should be closed.
+    bool serveBuffered(Loop &loop, Connection &connection)
+    {
+        while (connection.state == Connection::State::Reading)
+        {
+            HttpRequestParser::Status status = connection.parser.parse();
+            if (status == HttpRequestParser::Status::Error)
+            {
+                connection.output += HttpMessage::errorResponse(connection.parser.errorStatus());
+                connection.closeAfterWrite = true;
+                break;
+            }
+            if (status == HttpRequestParser::Status::Incomplete)
+            {
+                if (!connection.drained)
+                {
+                    // The last read stopped at the buffer limit; parsing has made room since
+                    if (!readAvailable(connection))
+                        return false;
+                    continue;
+                }
+                if (connection.peerClosed && connection.output.empty())
+                    return false;
+                break;
+            }
+
+            const HttpRequest &request = connection.parser.request();
+            ++connection.requestCount;
+            bool keepAliveAllowed = keepAlive.enabled() && !connection.peerClosed &&
+                                    connection.requestCount < keepAlive.maxRequests && request.wantsKeepAlive();
+            size_t requestsLeft = keepAlive.maxRequests - connection.requestCount;
+
+            if (pool)
+            {
+                connection.state = Connection::State::Processing;
+                untrack(loop, connection); // A slow handler is not an idle client
+                Connection *target = &connection;
+                bool queued = pool->trySubmit([this, &loop, target, keepAliveAllowed, requestsLeft]
+                                              { serveOnWorker(loop, target, keepAliveAllowed, requestsLeft); });
+                if (queued)
+                    return true;
+
+                connection.state = Connection::State::Reading;
+                touch(loop, connection);
+                connection.output += HttpMessage::errorResponse(503);
+                connection.closeAfterWrite = true;
+                break;
+            }
+
+            bool keepOpen;
+            connection.output += serve(request, keepAliveAllowed, requestsLeft, keepOpen);
+            connection.parser.next();
+            if (!keepOpen)
+            {
+                connection.closeAfterWrite = true;
+                break;
+            }
+        }
+
+        if (!connection.output.empty())
+            connection.state = Connection::State::Writing;
+        return true;
+    }
+
+    // Push a connection as far as it goes without blocking: serve buffered
+    // requests, write responses, read what was pipelined behind them. False
+    // when the connection should be closed.
+    bool advance(Loop &loop, Connection &connection)
+    {
+        for (;;)
+        {
+            switch (connection.state)
+            {
+            case Connection::State::Processing:
+                return true;
+
+            case Connection::State::Reading:
+                if (!serveBuffered(loop, connection))
+                    return false;
+                if (connection.state == Connection::State::Reading)
+                    return true; // Waiting for the rest of a request
+                break;
+
+            case Connection::State::Writing:
+                if (!writeAvailable(connection))
+                    return false;
+                if (connection.written < connection.output.size())
+                    return true; // Waiting for EPOLLOUT
+                if (connection.closeAfterWrite)
+                    return false;
+                connection.output.clear();
+                connection.written = 0;
+                connection.state = Connection::State::Reading;
+                if (!readAvailable(connection)) // Edge-triggered: data that arrived meanwhile raised no new event
+                    return false;
+                break;
+            }
+        }
+    }
+
+    // Advance a connection after an event; false when it should be closed
+    bool drive(Loop &loop, Connection &connection, std::uint32_t events)
+    {
+        // The worker owns the buffer for now; anything new is read once the
+        // response is written, and a dead connection is closed then
+        if (connection.state == Connection::State::Processing)
+            return true;
+        if (events & EPOLLERR)
+            return false;
+        if (!readAvailable(connection))
+            return false;
+
+        touch(loop, connection);
+        return advance(loop, connection);
+    }
+
+    void closeConnection(Loop &loop, Connection &connection)
+    {
+        untrack(loop, connection);
+        int fd = connection.fd;
+        close(fd); // Also drops it from the epoll set
+        loop.connections.erase(fd);
+    }
+
+    // Write out the responses workers have finished since the last wake-up
+    void drainFinished(Loop &loop)
+    {
+        std::uint64_t count;
+        ssize_t got = read(loop.wakeFd, &count, sizeof(count));
+        (void)got; // Only resets the eventfd; the list below is what matters
+
+        std::vector<Finished> finished;
+        {
+            std::lock_guard<std::mutex> lock(loop.finishedMutex);
+            finished.swap(loop.finished);
+        }
+        for (Finished &entry : finished)
+        {
+            Connection &connection = *entry.connection;
+            connection.parser.next();
+            connection.output = std::move(entry.response);
+            connection.written = 0;
+            connection.closeAfterWrite = !entry.keepOpen;
+            connection.state = Connection::State::Writing;
+            touch(loop, connection);
+            if (!advance(loop, connection))
+                closeConnection(loop, connection);
+        }
+    }
+
+    // Close connections that have been idle for longer than the keep-alive timeout
+    void closeIdle(Loop &loop)
+    {
+        auto cutoff = std::chrono::steady_clock::now() - keepAlive.idleTimeout;
+        while (!loop.idle.empty() && loop.idle.front()->lastActive <= cutoff)
+            closeConnection(loop, *loop.idle.front());
+    }
+
+    void acceptAll(Loop &loop)
+    {
+        for (;;)
+        {
+            int fd = accept4(listenSocket, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+            if (fd < 0)
+            {
+                if (errno == EINTR || errno == ECONNABORTED)
+                    continue;
+                if (errno == EMFILE || errno == ENFILE)
+                    std::cerr << "accept: out of file descriptors" << std::endl;
+                return; // EAGAIN: backlog drained
+            }
+
+            auto connection = std::make_unique<Connection>();
+            connection->fd = fd;
+            touch(loop, *connection);
+
+            epoll_event event{};
+            event.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+            event.data.ptr = connection.get();
+            if (epoll_ctl(loop.epollFd, EPOLL_CTL_ADD, fd, &event) < 0)
+            {
+                untrack(loop, *connection);
+                close(fd);
+                continue;
+            }
+            loop.connections[fd] = std::move(connection);
+        }
+    }
+
+    void runLoop(Loop &loop)
+    {
+        // Event data: null for the listening socket, &loop.wakeFd for the eventfd,
+        // otherwise the Connection
+        epoll_event listenEvent{};
+        listenEvent.events = EPOLLIN | EPOLLEXCLUSIVE;
+        listenEvent.data.ptr = nullptr;
+        epoll_ctl(loop.epollFd, EPOLL_CTL_ADD, listenSocket, &listenEvent);
+
+        epoll_event wakeEvent{};
+        wakeEvent.events = EPOLLIN;
+        wakeEvent.data.ptr = &loop.wakeFd;
+        epoll_ctl(loop.epollFd, EPOLL_CTL_ADD, loop.wakeFd, &wakeEvent);
+
+        // Without keep-alive there is no idle timeout, so no need to wake up for one
+        int timeout = keepAlive.enabled() ? SWEEP_INTERVAL_MS : -1;
+        std::vector<epoll_event> events(MAX_EVENTS);
+        for (;;)
+        {
+            int ready = epoll_wait(loop.epollFd, events.data(), MAX_EVENTS, timeout);
+            if (ready < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+                std::cerr << "epoll_wait: " << std::strerror(errno) << std::endl;
+                return;
+            }
+
+            for (int i = 0; i < ready; ++i)
+            {
+                void *data = events[i].data.ptr;
+                if (!data)
+                {
+                    acceptAll(loop);
+                }
+                else if (data == &loop.wakeFd)
+                {
+                    drainFinished(loop);
+                }
+                else
+                {
+                    auto *connection = static_cast<Connection *>(data);
+                    if (!drive(loop, *connection, events[i].events))
+                        closeConnection(loop, *connection);
+                }
+            }
+            if (keepAlive.enabled())
+                closeIdle(loop);
+        }
+    }
+
+    // Lift the soft descriptor limit to the hard limit; every connection holds one
+    static void raiseDescriptorLimit()
+    {
+        rlimit limit;
+        if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < limit.rlim_max)
+        {
+            limit.rlim_cur = limit.rlim_max;
+            setrlimit(RLIMIT_NOFILE, &limit);
+        }
+    }
+
+public:
+    // Loops default to one per hardware thread
+    static size_t defaultLoopCount()
+    {
+        return std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    // With a pool, requests are handled on its workers; otherwise on the loop threads
+    EpollReactor(int listenSocket, size_t loopCount, Handler handler, WorkerPool *pool = nullptr,
+                 KeepAlivePolicy keepAlive = KeepAlivePolicy())
+        : listenSocket(listenSocket), loopCount(std::max<size_t>(1, loopCount)), handler(std::move(handler)), pool(pool),
+          keepAlive(keepAlive)
+    {
+    }
+
+    EpollReactor(const EpollReactor &) = delete;
+    EpollReactor &operator=(const EpollReactor &) = delete;
+
+    // Serve on loopCount threads (the caller's included); runs until the process exits
+    void run()
+    {
+        fcntl(listenSocket, F_SETFL, fcntl(listenSocket, F_GETFL) | O_NONBLOCK);
+        raiseDescriptorLimit();
+
+        for (size_t i = 0; i < loopCount; ++i)
+        {
+            auto loop = std::make_unique<Loop>();
+            loop->epollFd = epoll_create1(EPOLL_CLOEXEC);
+            loop->wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+            if (loop->epollFd < 0 || loop->wakeFd < 0)
+            {
+                std::cerr << "epoll/eventfd: " << std::strerror(errno) << std::endl;
+                return;
+            }
+            loops.push_back(std::move(loop));
+        }
+
+        std::vector<std::thread> threads;
+        for (size_t i = 1; i < loopCount; ++i)
+            threads.emplace_back(&EpollReactor::runLoop, this, std::ref(*loops[i]));
+        runLoop(*loops[0]);
+        for (auto &thread : threads)
+            thread.join();
+    }
+};
+
+#endif // __linux__
+
+#endif // EPOLLREACTOR_H
@@ -0,0 +1,106 @@
+#ifndef FORMFIELDS_H
+#define FORMFIELDS_H
+
+#include <array>
+#include <cstddef>
+#include <string_view>
+#include <utility>
+
+// Fields of a query string or application/x-www-form-urlencoded body, as a small
+// flat map of views. parse() percent-decodes the text where it lies (decoding
+// only ever shortens it), so no field is copied or allocated.
+class FormFields
+{
+public:
+    static constexpr size_t CAPACITY = 16; // Fields past this many are ignored
+
+private:
+    std::array<std::pair<std::string_view, std::string_view>, CAPACITY> fields;
+    size_t count = 0;
+
+    static int hexValue(char c)
+    {
+        if (c >= '0' && c <= '9')
+            return c - '0';
+        if (c >= 'a' && c <= 'f')
+            return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F')
+            return c - 'A' + 10;
+        return -1;
+    }
+
+public:
+    // Decode %XX escapes and '+' in place; returns the decoded length. A '%'
+    // not followed by two hex digits is kept as it is.
+    static size_t percentDecode(char *text, size_t length)
+    {
+        size_t out = 0;
+        for (size_t in = 0; in < length; ++in)
+        {
+            char c = text[in];
+            if (c == '+')
+            {
+                c = ' ';
+            }
+            else if (c == '%' && in + 2 < length && hexValue(text[in + 1]) >= 0 && hexValue(text[in + 2]) >= 0)
+            {
+                c = static_cast<char>(hexValue(text[in + 1]) * 16 + hexValue(text[in + 2]));
+                in += 2;
+            }
+            text[out++] = c;
+        }
+        return out;
+    }
+
+    // Split 'text' into name=value pairs and decode each in place. Pairs without
+    // '=' are skipped. Splitting comes first, so an escaped '&' or '=' stays data.
+    void parse(char *text, size_t length)
+    {
+        count = 0;
+        size_t start = 0;
+        while (start < length && count < CAPACITY)
+        {
+            size_t end = start;
+            size_t equals = length;
+            while (end < length && text[end] != '&')
+            {
+                if (equals == length && text[end] == '=')
+                    equals = end;
+                ++end;
+            }
+
+            if (equals < end)
+            {
+                size_t nameLength = percentDecode(text + start, equals - start);
+                size_t valueLength = percentDecode(text + equals + 1, end - equals - 1);
+                fields[count++] = {{text + start, nameLength}, {text + equals + 1, valueLength}};
+            }
+            start = end + 1;
+        }
+    }
+
+    // Value of the last field called 'name', or 'fallback'
+    std::string_view get(std::string_view name, std::string_view fallback = {}) const
+    {
+        for (size_t i = count; i-- > 0;)
+        {
+            if (fields[i].first == name)
+                return fields[i].second;
+        }
+        return fallback;
+    }
+
+    bool contains(std::string_view name) const
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (fields[i].first == name)
+                return true;
+        }
+        return false;
+    }
+
+    size_t size() const { return count; }
+};
+
+#endif // FORMFIELDS_H
@@ -0,0 +1,101 @@
+#ifndef HTTPMESSAGE_H
+#define HTTPMESSAGE_H
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <string>
+#include <string_view>
+
+// When a connection may stay open after a response
+struct KeepAlivePolicy
+{
+    std::chrono::seconds idleTimeout{5}; // Close after this long without a request; 0 disables keep-alive
+    size_t maxRequests = 100;            // Close after this many requests on one connection
+
+    bool enabled() const { return idleTimeout.count() > 0 && maxRequests > 1; }
+};
+
+// Response-side helpers shared by both connection models: error responses, and
+// the headers that say whether the connection stays open. Requests are framed by
+// HttpRequestParser.
+class HttpMessage
+{
+public:
+    // Value of header 'name' (lower case) in the head of 'message', or empty
+    static std::string_view headerValue(std::string_view message, std::string_view name)
+    {
+        size_t headEnd = message.find("\r\n\r\n");
+        std::string_view head = message.substr(0, headEnd);
+        size_t lineStart = head.find("\r\n");
+        while (lineStart != std::string_view::npos)
+        {
+            lineStart += 2;
+            size_t lineEnd = head.find("\r\n", lineStart);
+            std::string_view line = head.substr(lineStart, lineEnd == std::string_view::npos ? std::string_view::npos : lineEnd - lineStart);
+            if (line.size() > name.size() && line[name.size()] == ':' &&
+                std::equal(name.begin(), name.end(), line.begin(), [](char n, char c)
+                           { return n == std::tolower(static_cast<unsigned char>(c)); }))
+            {
+                std::string_view value = line.substr(name.size() + 1);
+                while (!value.empty() && (value.front() == ' ' || value.front() == '\t'))
+                    value.remove_prefix(1);
+                while (!value.empty() && (value.back() == ' ' || value.back() == '\t'))
+                    value.remove_suffix(1);
+                return value;
+            }
+            lineStart = lineEnd;
+        }
+        return {};
+    }
+
+    static bool equalsIgnoreCase(std::string_view a, std::string_view b)
+    {
+        return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(), [](char x, char y)
+                                                  { return std::tolower(static_cast<unsigned char>(x)) ==
+                                                           std::tolower(static_cast<unsigned char>(y)); });
+    }
+
+    // Bodiless response that closes the connection, for requests that cannot be served
+    static std::string errorResponse(int status)
+    {
+        const char *reason = "Bad Request";
+        switch (status)
+        {
+        case 413:
+            reason = "Payload Too Large";
+            break;
+        case 431:
+            reason = "Request Header Fields Too Large";
+            break;
+        case 500:
+            reason = "Internal Server Error";
+            break;
+        case 501:
+            reason = "Not Implemented";
+            break;
+        case 503:
+            return "HTTP/1.1 503 Service Unavailable\r\nRetry-After: 1\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+        }
+        return "HTTP/1.1 " + std::to_string(status) + " " + reason + "\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+    }
+
+    // Add the Connection header to a response. 'keepAlive' is what the request
+    // and policy allow; responses that already say "Connection: close" (errors,
+    // overload) always close. Returns whether the connection stays open.
+    static bool finishResponse(std::string &response, bool keepAlive, const KeepAlivePolicy &policy, size_t requestsLeft)
+    {
+        if (equalsIgnoreCase(headerValue(response, "connection"), "close"))
+            return false;
+
+        std::string header = keepAlive ? "Connection: keep-alive\r\nKeep-Alive: timeout=" + std::to_string(policy.idleTimeout.count()) +
+                                             ", max=" + std::to_string(requestsLeft) + "\r\n"
+                                       : std::string("Connection: close\r\n");
+        size_t statusEnd = response.find("\r\n");
+        if (statusEnd != std::string::npos)
+            response.insert(statusEnd + 2, header);
+        return keepAlive;
+    }
+};
+
+#endif // HTTPMESSAGE_H
@@ -0,0 +1,493 @@
+#ifndef HTTPREQUESTPARSER_H
+#define HTTPREQUESTPARSER_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <string_view>
+#include <vector>
+#include "HttpMessage.h"
+
+struct HttpHeader
+{
+    std::string_view name;
+    std::string_view value;
+};
+
+// One parsed request. Every view points into the parser's buffer and is valid
+// until the parser's next() or prepare().
+struct HttpRequest
+{
+    std::string_view method;
+    std::string_view target; // Path plus query string, as sent
+    std::string_view version;
+    std::vector<HttpHeader> headers; // Capacity is reused from request to request
+    std::string_view body;           // Chunked bodies are already joined
+
+    // Value of header 'name' (any case), or empty
+    std::string_view header(std::string_view name) const
+    {
+        for (const HttpHeader &h : headers)
+        {
+            if (HttpMessage::equalsIgnoreCase(h.name, name))
+                return h.value;
+        }
+        return {};
+    }
+
+    // The bytes behind a view belong to the parser's buffer, which is writable
+    // until next(), so a handler may rewrite parts of the target or body in
+    // place (e.g. percent-decoding, which only shortens text)
+    static char *writable(std::string_view part)
+    {
+        return const_cast<char *>(part.data());
+    }
+
+    // HTTP/1.1 keeps the connection unless it sends "Connection: close",
+    // HTTP/1.0 only with "Connection: keep-alive"
+    bool wantsKeepAlive() const
+    {
+        std::string_view connection = header("connection");
+        if (version == "HTTP/1.1")
+            return !HttpMessage::equalsIgnoreCase(connection, "close");
+        return HttpMessage::equalsIgnoreCase(connection, "keep-alive");
+    }
+};
+
+// Incremental request parser that owns a connection's receive buffer. The
+// socket reads straight into the buffer (prepare() / commit()), and parse()
+// picks up where it stopped, so a request split over any number of reads is
+// scanned once. Content-Length and chunked bodies are both supported; chunks
+// are joined in place by moving their data down over the chunk-size lines, so
+// the body ends up contiguous without another copy. Bytes after a complete
+// request (pipelining) stay in the buffer for the next parse().
+class HttpRequestParser
+{
+public:
+    enum class Status
+    {
+        Incomplete, // Needs more bytes
+        Complete,   // request() is ready
+        Error       // errorStatus() says which; the connection should be closed
+    };
+
+    static constexpr size_t MAX_HEAD_SIZE = 64 * 1024;                // Request line plus headers
+    static constexpr size_t MAX_HEADERS = 100;
+    static constexpr size_t DEFAULT_MAX_BODY_SIZE = size_t(64) << 20; // Larger bodies get a 413
+
+private:
+    enum class State
+    {
+        Head,
+        Body,      // Content-Length body
+        ChunkSize, // Chunk-size line
+        ChunkData,
+        ChunkEnd, // CRLF after chunk data
+        Trailers,
+        Complete,
+        Error
+    };
+
+    // Positions in the buffer are relative to 'begin', so the buffer can be
+    // moved or compacted while a request is still arriving
+    struct Span
+    {
+        size_t offset = 0;
+        size_t length = 0;
+    };
+
+    struct HeaderSpan
+    {
+        Span name;
+        Span value;
+    };
+
+    static constexpr size_t INITIAL_CAPACITY = 4096;
+    static constexpr size_t SHRINK_ABOVE = size_t(1) << 20; // Idle buffers bigger than this are released
+    static constexpr size_t MAX_CHUNK_LINE = 1024;
+
+    std::unique_ptr<char[]> data; // Not zero-filled; only [begin, end) is meaningful
+    size_t capacity = 0;
+    size_t begin = 0; // Start of the request being parsed
+    size_t end = 0;   // End of the received bytes
+    size_t maxBodySize;
+
+    State state = State::Head;
+    size_t cursor = 0;    // Next byte to look at
+    size_t bodyStart = 0;
+    size_t bodyEnd = 0;   // End of the body joined so far
+    size_t remaining = 0; // Bytes still to come of the body or current chunk
+    size_t trailerStart = 0;
+    int errorCode = 0;
+
+    Span methodSpan, targetSpan, versionSpan;
+    std::vector<HeaderSpan> headerSpans;
+    HttpRequest parsed;
+
+    const char *at(size_t offset) const { return data.get() + begin + offset; }
+    char *at(size_t offset) { return data.get() + begin + offset; }
+    size_t available() const { return end - begin; }
+    std::string_view view(Span span) const { return {at(span.offset), span.length}; }
+
+    // Position of the next CRLF at or after 'from', or npos
+    size_t findLineEnd(size_t from) const
+    {
+        std::string_view bytes(at(0), available());
+        return bytes.find("\r\n", from);
+    }
+
+    Status fail(int status)
+    {
+        errorCode = status;
+        state = State::Error;
+        return Status::Error;
+    }
+
+    // Make room for at least 'bytes' more received bytes, moving the current
+    // request to the front of the buffer if that helps
+    void makeRoom(size_t bytes)
+    {
+        if (capacity - end >= bytes)
+            return;
+
+        size_t used = available();
+        if (begin > 0 && capacity - used >= bytes)
+        {
+            std::memmove(data.get(), data.get() + begin, used);
+        }
+        else
+        {
+            size_t newCapacity = std::max({used + bytes, capacity * 2, INITIAL_CAPACITY});
+            std::unique_ptr<char[]> grown(new char[newCapacity]);
+            if (used)
+                std::memcpy(grown.get(), data.get() + begin, used);
+            data = std::move(grown);
+            capacity = newCapacity;
+        }
+        begin = 0;
+        end = used;
+    }
+
+    static bool parseDecimal(std::string_view text, size_t &value)
+    {
+        if (text.empty())
+            return false;
+        value = 0;
+        for (char c : text)
+        {
+            if (c < '0' || c > '9' || value > (static_cast<size_t>(-1) - 9) / 10)
+                return false;
+            value = value * 10 + static_cast<size_t>(c - '0');
+        }
+        return true;
+    }
+
+    static int hexDigit(char c)
+    {
+        if (c >= '0' && c <= '9')
+            return c - '0';
+        if (c >= 'a' && c <= 'f')
+            return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F')
+            return c - 'A' + 10;
+        return -1;
+    }
+
+    // Request line and headers, once the blank line after them has arrived
+    Status parseHead()
+    {
+        // Tolerate blank lines before a request (some clients send CRLF after a body)
+        while (available() >= 2 && at(0)[0] == '\r' && at(0)[1] == '\n')
+        {
+            begin += 2;
+            cursor = 0;
+        }
+
+        std::string_view bytes(at(0), available());
+        size_t headEnd = bytes.find("\r\n\r\n", cursor >= 3 ? cursor - 3 : 0);
+        if (headEnd == std::string_view::npos)
+        {
+            cursor = bytes.size();
+            if (bytes.size() > MAX_HEAD_SIZE)
+                return fail(431);
+            return Status::Incomplete;
+        }
+        if (headEnd + 4 > MAX_HEAD_SIZE)
+            return fail(431);
+
+        // method SP target SP HTTP/1.x
+        size_t lineEnd = bytes.find("\r\n");
+        size_t firstSpace = bytes.find(' ');
+        size_t secondSpace = firstSpace < lineEnd ? bytes.find(' ', firstSpace + 1) : std::string_view::npos;
+        if (firstSpace == 0 || secondSpace >= lineEnd || secondSpace == firstSpace + 1 ||
+            lineEnd - secondSpace - 1 != 8 || bytes.compare(secondSpace + 1, 7, "HTTP/1.") != 0)
+            return fail(400);
+        methodSpan = {0, firstSpace};
+        targetSpan = {firstSpace + 1, secondSpace - firstSpace - 1};
+        versionSpan = {secondSpace + 1, 8};
+
+        headerSpans.clear();
+        for (size_t lineStart = lineEnd + 2; lineStart < headEnd + 2; lineStart = lineEnd + 2)
+        {
+            lineEnd = bytes.find("\r\n", lineStart);
+            size_t colon = bytes.find(':', lineStart);
+            if (colon >= lineEnd || colon == lineStart || bytes[colon - 1] == ' ' || bytes[colon - 1] == '\t')
+                return fail(400);
+            if (headerSpans.size() == MAX_HEADERS)
+                return fail(431);
+
+            size_t valueStart = colon + 1;
+            size_t valueEnd = lineEnd;
+            while (valueStart < valueEnd && (bytes[valueStart] == ' ' || bytes[valueStart] == '\t'))
+                ++valueStart;
+            while (valueEnd > valueStart && (bytes[valueEnd - 1] == ' ' || bytes[valueEnd - 1] == '\t'))
+                --valueEnd;
+            headerSpans.push_back({{lineStart, colon - lineStart}, {valueStart, valueEnd - valueStart}});
+        }
+
+        bodyStart = bodyEnd = cursor = headEnd + 4;
+        return frameBody();
+    }
+
+    // Decide how the body is delimited. Conflicting framing is rejected rather
+    // than guessed at, so a proxy in front cannot be made to disagree with us.
+    Status frameBody()
+    {
+        bool hasLength = false;
+        bool chunked = false;
+        size_t length = 0;
+        for (const HeaderSpan &h : headerSpans)
+        {
+            std::string_view name = view(h.name);
+            std::string_view value = view(h.value);
+            if (HttpMessage::equalsIgnoreCase(name, "content-length"))
+            {
+                size_t parsedLength;
+                if (!parseDecimal(value, parsedLength) || (hasLength && parsedLength != length))
+                    return fail(400);
+                hasLength = true;
+                length = parsedLength;
+            }
+            else if (HttpMessage::equalsIgnoreCase(name, "transfer-encoding"))
+            {
+                if (chunked || !HttpMessage::equalsIgnoreCase(value, "chunked"))
+                    return fail(501);
+                chunked = true;
+            }
+        }
+
+        if (chunked)
+        {
+            if (hasLength)
+                return fail(400);
+            state = State::ChunkSize;
+        }
+        else if (hasLength)
+        {
+            if (length > maxBodySize)
+                return fail(413);
+            remaining = length;
+            state = State::Body;
+            // Size the buffer for the whole body up front so it is never moved while
+            // arriving; pages the body has not reached yet are not touched
+            makeRoom(bodyStart + length - std::min(available(), bodyStart + length));
+        }
+        else
+        {
+            complete();
+        }
+        return Status::Incomplete;
+    }
+
+    Status parseChunkSize()
+    {
+        size_t lineEnd = findLineEnd(cursor);
+        if (lineEnd == std::string_view::npos)
+            return available() - cursor > MAX_CHUNK_LINE ? fail(400) : Status::Incomplete;
+
+        // Hex size, then optional ";extension" which is ignored
+        size_t size = 0;
+        size_t i = cursor;
+        for (int digit; i < lineEnd && (digit = hexDigit(*at(i))) >= 0; ++i)
+        {
+            if (size > (static_cast<size_t>(-1) >> 4))
+                return fail(413);
+            size = size * 16 + static_cast<size_t>(digit);
+        }
+        if (i == cursor || (i < lineEnd && *at(i) != ';' && *at(i) != ' ' && *at(i) != '\t'))
+            return fail(400);
+        if (size > maxBodySize - (bodyEnd - bodyStart))
+            return fail(413);
+
+        cursor = lineEnd + 2;
+        if (size == 0)
+        {
+            trailerStart = cursor;
+            state = State::Trailers;
+        }
+        else
+        {
+            remaining = size;
+            state = State::ChunkData;
+        }
+        return Status::Incomplete;
+    }
+
+    // Move what has arrived of the current chunk down to the end of the body
+    Status parseChunkData()
+    {
+        size_t n = std::min(remaining, available() - cursor);
+        if (n && bodyEnd != cursor)
+            std::memmove(at(bodyEnd), at(cursor), n);
+        bodyEnd += n;
+        cursor += n;
+        remaining -= n;
+        if (remaining == 0)
+            state = State::ChunkEnd;
+        return Status::Incomplete;
+    }
+
+    Status parseChunkEnd()
+    {
+        if (available() - cursor < 2)
+            return Status::Incomplete;
+        if (at(cursor)[0] != '\r' || at(cursor)[1] != '\n')
+            return fail(400);
+        cursor += 2;
+        state = State::ChunkSize;
+        return Status::Incomplete;
+    }
+
+    // Trailer fields are skipped up to the blank line that ends the message
+    Status parseTrailers()
+    {
+        size_t lineEnd = findLineEnd(cursor);
+        if (lineEnd == std::string_view::npos)
+            return available() - trailerStart > MAX_HEAD_SIZE ? fail(431) : Status::Incomplete;
+
+        bool blank = lineEnd == cursor;
+        cursor = lineEnd + 2;
+        if (blank)
+            complete();
+        return Status::Incomplete;
+    }
+
+    void complete()
+    {
+        parsed.method = view(methodSpan);
+        parsed.target = view(targetSpan);
+        parsed.version = view(versionSpan);
+        parsed.headers.clear();
+        for (const HeaderSpan &h : headerSpans)
+            parsed.headers.push_back({view(h.name), view(h.value)});
+        parsed.body = std::string_view(at(bodyStart), bodyEnd - bodyStart);
+        state = State::Complete;
+    }
+
+public:
+    explicit HttpRequestParser(size_t maxBodySize = DEFAULT_MAX_BODY_SIZE) : maxBodySize(maxBodySize) {}
+
+    HttpRequestParser(const HttpRequestParser &) = delete;
+    HttpRequestParser &operator=(const HttpRequestParser &) = delete;
+
+    // Space for the next read: at least 'bytes', and writable() in total.
+    // Invalidates request().
+    char *prepare(size_t bytes)
+    {
+        makeRoom(bytes);
+        return data.get() + end;
+    }
+
+    size_t writable() const { return capacity - end; }
+
+    // Count 'bytes' written at prepare() as received
+    void commit(size_t bytes) { end += bytes; }
+
+    void append(const char *bytes, size_t length)
+    {
+        std::memcpy(prepare(length), bytes, length);
+        commit(length);
+    }
+
+    // Continue parsing with whatever has been received
+    Status parse()
+    {
+        for (;;)
+        {
+            Status status = Status::Incomplete;
+            size_t before = cursor;
+            State from = state;
+            switch (state)
+            {
+            case State::Head:
+                status = parseHead();
+                break;
+            case State::Body:
+                if (available() - bodyStart >= remaining)
+                {
+                    bodyEnd = cursor = bodyStart + remaining;
+                    complete();
+                }
+                break;
+            case State::ChunkSize:
+                status = parseChunkSize();
+                break;
+            case State::ChunkData:
+                status = parseChunkData();
+                break;
+            case State::ChunkEnd:
+                status = parseChunkEnd();
+                break;
+            case State::Trailers:
+                status = parseTrailers();
+                break;
+            case State::Complete:
+                return Status::Complete;
+            case State::Error:
+                return Status::Error;
+            }
+            if (status == Status::Error)
+                return status;
+            if (state == from && cursor == before)
+            {
+                // Waiting for more bytes. Chunk framing is the only overhead not
+                // limited elsewhere, so this also bounds a chunked message.
+                if (available() > maxMessageSize())
+                    return fail(413);
+                return Status::Incomplete;
+            }
+        }
+    }
+
+    const HttpRequest &request() const { return parsed; }
+
+    // Status code for the response to a malformed request (400, 413, 431, 501)
+    int errorStatus() const { return errorCode; }
+
+    // Drop the completed request; bytes pipelined after it are kept
+    void next()
+    {
+        begin += cursor;
+        state = State::Head;
+        cursor = bodyStart = bodyEnd = remaining = 0;
+        if (begin == end)
+        {
+            begin = end = 0;
+            if (capacity > SHRINK_ABOVE)
+            {
+                data.reset();
+                capacity = 0;
+            }
+        }
+    }
+
+    // Bytes received and not yet consumed by next()
+    size_t buffered() const { return available(); }
+
+    // Most bytes one incomplete request may occupy in the buffer; a caller that
+    // stops reading past this can count on parse() making progress
+    size_t maxMessageSize() const { return MAX_HEAD_SIZE + maxBodySize + maxBodySize / 8; }
+};
+
+#endif // HTTPREQUESTPARSER_H
@@ -0,0 +1,150 @@
+#ifndef INDEXEDHEAP_H
+#define INDEXEDHEAP_H
+
+#include <vector>
+#include <memory_resource>
+#include <unordered_map>
+#include <functional>
+#include <utility>
+
+// Binary heap of (id, key) entries that also remembers where each id sits, so
+// an entry can be found, re-keyed or removed by id in O(log n). The entry for
+// which 'before' holds against every other entry is at the top.
+template <typename Id, typename Key, typename Before = std::less<Key>>
+class IndexedHeap
+{
+public:
+    struct Entry
+    {
+        Id id;
+        Key key;
+    };
+
+private:
+    std::pmr::vector<Entry> heap;
+    std::pmr::unordered_map<Id, size_t> position; // id -> index in heap
+    Before before;
+
+    void place(size_t i)
+    {
+        position[heap[i].id] = i;
+    }
+
+    void swapEntries(size_t a, size_t b)
+    {
+        std::swap(heap[a], heap[b]);
+        place(a);
+        place(b);
+    }
+
+    void siftUp(size_t i)
+    {
+        while (i > 0)
+        {
+            size_t parent = (i - 1) / 2;
+            if (!before(heap[i].key, heap[parent].key))
+                break;
+            swapEntries(i, parent);
+            i = parent;
+        }
+    }
+
+    void siftDown(size_t i)
+    {
+        for (;;)
+        {
+            size_t best = i;
+            size_t left = 2 * i + 1;
+            size_t right = left + 1;
+            if (left < heap.size() && before(heap[left].key, heap[best].key))
+                best = left;
+            if (right < heap.size() && before(heap[right].key, heap[best].key))
+                best = right;
+            if (best == i)
+                break;
+            swapEntries(i, best);
+            i = best;
+        }
+    }
+
+    void removeAt(size_t i)
+    {
+        position.erase(heap[i].id);
+        size_t last = heap.size() - 1;
+        if (i != last)
+        {
+            heap[i] = std::move(heap[last]);
+            place(i);
+        }
+        heap.pop_back();
+        if (i < heap.size())
+        {
+            siftUp(i);
+            siftDown(i);
+        }
+    }
+
+public:
+    explicit IndexedHeap(std::pmr::memory_resource *resource = std::pmr::get_default_resource())
+        : heap(resource), position(resource)
+    {
+    }
+
+    bool empty() const { return heap.empty(); }
+    size_t size() const { return heap.size(); }
+    bool contains(Id id) const { return position.count(id) != 0; }
+
+    // Entry at the top of the heap (heap must not be empty)
+    const Entry &top() const { return heap.front(); }
+
+    void push(Id id, const Key &key)
+    {
+        heap.push_back({id, key});
+        place(heap.size() - 1);
+        siftUp(heap.size() - 1);
+    }
+
+    void pop()
+    {
+        removeAt(0);
+    }
+
+    // Remove an arbitrary entry by id
+    bool erase(Id id)
+    {
+        auto it = position.find(id);
+        if (it == position.end())
+            return false;
+
+        removeAt(it->second);
+        return true;
+    }
+
+    // Change an entry's key in either direction (decrease-key or increase-key)
+    bool update(Id id, const Key &key)
+    {
+        auto it = position.find(id);
+        if (it == position.end())
+            return false;
+
+        size_t i = it->second;
+        heap[i].key = key;
+        siftUp(i);
+        siftDown(position[id]);
+        return true;
+    }
+
+    void reserve(size_t n)
+    {
+        heap.reserve(n);
+        position.reserve(n);
+    }
+
+    void clear()
+    {
+        heap.clear();
+        position.clear();
+    }
+};
+
+#endif // INDEXEDHEAP_H
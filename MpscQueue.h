@@ -0,0 +1,102 @@
+#ifndef MPSCQUEUE_H
+#define MPSCQUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+// Bounded lock-free queue for many producers and a single consumer, after
+// Dmitry Vyukov's bounded MPMC ring. Each cell carries a sequence number that
+// says whether it is free for the producer claiming position 'pos' (== pos) or
+// holds a value for the consumer (== pos + 1). Producers claim positions with a
+// CAS on 'tail'; the consumer owns 'head' outright and needs no atomics for it.
+//
+// T must be default-constructible and move-assignable. Capacity is rounded up to
+// a power of two.
+template <typename T>
+class MpscQueue
+{
+private:
+    struct Cell
+    {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    std::unique_ptr<Cell[]> cells;
+    size_t mask;
+    alignas(64) std::atomic<size_t> tail{0}; // Next position for producers
+    alignas(64) size_t head = 0;             // Next position for the consumer
+
+public:
+    explicit MpscQueue(size_t capacity)
+    {
+        size_t size = 2;
+        while (size < capacity)
+            size *= 2;
+
+        cells.reset(new Cell[size]);
+        mask = size - 1;
+        for (size_t i = 0; i < size; ++i)
+        {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscQueue(const MpscQueue &) = delete;
+    MpscQueue &operator=(const MpscQueue &) = delete;
+
+    size_t capacity() const { return mask + 1; }
+
+    // Move 'value' in if there is room; leaves it untouched and returns false when full
+    bool tryPush(T &value)
+    {
+        size_t pos = tail.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            Cell &cell = cells[pos & mask];
+            size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            std::intptr_t diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(pos);
+            if (diff == 0)
+            {
+                if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    cell.value = std::move(value);
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (diff < 0)
+            {
+                return false; // The consumer has not freed this cell yet
+            }
+            else
+            {
+                pos = tail.load(std::memory_order_relaxed); // Another producer took it
+            }
+        }
+    }
+
+    // Consumer only
+    bool tryPop(T &out)
+    {
+        Cell &cell = cells[head & mask];
+        if (cell.sequence.load(std::memory_order_acquire) != head + 1)
+            return false;
+
+        out = std::move(cell.value);
+        cell.sequence.store(head + mask + 1, std::memory_order_release);
+        ++head;
+        return true;
+    }
+
+    // Consumer only
+    bool empty() const
+    {
+        return cells[head & mask].sequence.load(std::memory_order_acquire) != head + 1;
+    }
+};
+
+#endif // MPSCQUEUE_H
@@ -0,0 +1,147 @@
+#ifndef ROUTER_H
+#define ROUTER_H
+
+#include <array>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Path parameters captured by a route match, as views into the request path
+struct RouteParams
+{
+    static constexpr size_t CAPACITY = 4;
+
+    std::array<std::pair<std::string_view, std::string_view>, CAPACITY> entries;
+    size_t count = 0;
+
+    std::string_view get(std::string_view name) const
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (entries[i].first == name)
+                return entries[i].second;
+        }
+        return {};
+    }
+};
+
+// Route table as a trie of path segments. Patterns are like "/boards/:board/tasks":
+// a ":name" segment matches any one segment and captures it, and a trailing '/'
+// is a segment of its own ("/" is the single empty segment). Literal segments
+// are tried before a parameter at the same position. The table is built once;
+// matching walks the path in place and allocates nothing.
+template <typename Handler>
+class Router
+{
+private:
+    static constexpr size_t NONE = static_cast<size_t>(-1);
+
+    struct Node
+    {
+        std::vector<std::pair<std::string, size_t>> children; // Literal segment -> node index
+        size_t paramChild = NONE;
+        std::string paramName;
+        std::vector<std::pair<std::string, Handler>> handlers; // Method ("" for any) -> handler
+    };
+
+    std::vector<Node> nodes = std::vector<Node>(1); // nodes[0] is the root
+
+    // Split off the first segment of 'rest'; false when it was the last one
+    static bool nextSegment(std::string_view &rest, std::string_view &segment)
+    {
+        size_t slash = rest.find('/');
+        segment = rest.substr(0, slash);
+        if (slash == std::string_view::npos)
+            return false;
+        rest.remove_prefix(slash + 1);
+        return true;
+    }
+
+    size_t child(size_t node, std::string_view segment)
+    {
+        if (segment.size() > 1 && segment[0] == ':')
+        {
+            if (nodes[node].paramChild == NONE)
+            {
+                nodes[node].paramChild = nodes.size();
+                nodes[node].paramName = std::string(segment.substr(1));
+                nodes.emplace_back();
+            }
+            return nodes[node].paramChild;
+        }
+
+        for (const auto &entry : nodes[node].children)
+        {
+            if (entry.first == segment)
+                return entry.second;
+        }
+        nodes[node].children.emplace_back(std::string(segment), nodes.size());
+        nodes.emplace_back();
+        return nodes.size() - 1;
+    }
+
+    const Handler *handlerFor(size_t node, std::string_view method) const
+    {
+        for (const auto &entry : nodes[node].handlers)
+        {
+            if (entry.first.empty() || entry.first == method)
+                return &entry.second;
+        }
+        return nullptr;
+    }
+
+    const Handler *matchFrom(size_t node, std::string_view rest, std::string_view method, RouteParams &params) const
+    {
+        std::string_view segment;
+        bool more = nextSegment(rest, segment);
+
+        for (const auto &entry : nodes[node].children)
+        {
+            if (entry.first == segment)
+            {
+                const Handler *found = more ? matchFrom(entry.second, rest, method, params) : handlerFor(entry.second, method);
+                if (found)
+                    return found;
+                break;
+            }
+        }
+
+        size_t param = nodes[node].paramChild;
+        if (param == NONE || params.count == RouteParams::CAPACITY)
+            return nullptr;
+        params.entries[params.count++] = {nodes[node].paramName, segment};
+        const Handler *found = more ? matchFrom(param, rest, method, params) : handlerFor(param, method);
+        if (!found)
+            --params.count;
+        return found;
+    }
+
+public:
+    // 'pattern' starts with '/'; an empty 'method' accepts any method
+    void add(std::string_view method, std::string_view pattern, Handler handler)
+    {
+        std::string_view rest = pattern.substr(1);
+        std::string_view segment;
+        size_t node = 0;
+        bool more;
+        do
+        {
+            more = nextSegment(rest, segment);
+            node = child(node, segment);
+        } while (more);
+        nodes[node].handlers.emplace_back(std::string(method), std::move(handler));
+    }
+
+    // Handler for 'method' on 'path', filling 'params'; nullptr when nothing matches
+    const Handler *match(std::string_view method, std::string_view path, RouteParams &params) const
+    {
+        params.count = 0;
+        if (path.empty() || path[0] != '/')
+            return nullptr;
+        return matchFrom(0, path.substr(1), method, params);
+    }
+};
+
+#endif // ROUTER_H
@@ -0,0 +1,232 @@
+#ifndef SHAREDTASKMANAGER_H
+#define SHAREDTASKMANAGER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <type_traits>
+#include "TaskManager.h"
+#include "ConcurrentTaskMap.h"
+#include "TaskSnapshot.h"
+
+// Counters for one lock mode; all times in nanoseconds
+struct LockModeStats
+{
+    std::uint64_t acquisitions = 0;
+    std::uint64_t totalWait = 0; // Time spent blocked before getting the lock
+    std::uint64_t totalHold = 0; // Time spent inside the critical section
+    std::uint64_t maxHold = 0;
+};
+
+struct LockStats
+{
+    LockModeStats shared;    // Readers
+    LockModeStats exclusive; // Writers
+
+    std::string toJson() const
+    {
+        auto mode = [](const LockModeStats &s)
+        {
+            return "{\"acquisitions\":" + std::to_string(s.acquisitions) +
+                   ",\"totalWaitNs\":" + std::to_string(s.totalWait) +
+                   ",\"totalHoldNs\":" + std::to_string(s.totalHold) +
+                   ",\"maxHoldNs\":" + std::to_string(s.maxHold) + "}";
+        };
+        return "{\"shared\":" + mode(shared) + ",\"exclusive\":" + mode(exclusive) + "}";
+    }
+};
+
+// A TaskManager guarded by a reader/writer lock. Readers (listing, rendering,
+// queries) run concurrently under a shared lock; mutations take the lock
+// exclusively. Every acquisition records how long it waited and how long the
+// lock was held, so contention can be observed at runtime.
+//
+// The writer also keeps an immutable TaskSnapshot current. Through the
+// manager's observer hook, every stored task becomes one shared immutable copy
+// that goes both into a lock-free ID map (for point lookups) and into chunked
+// snapshot rows; at the end of each write a new snapshot sharing the unchanged
+// chunks is published. A write therefore costs the chunks it touched plus the
+// chunk pointer arrays, never a copy of the board, and snapshot() is a single
+// atomic load: long-running readers (page rendering) work on a snapshot without
+// taking the lock.
+//
+// A board in Monotonic memory never reuses what it frees, so after a write that
+// leaves too much dead memory (TaskManager::shouldRebuild) the tasks are copied
+// into a fresh manager and the old one, with all its blocks, is dropped.
+class SharedTaskManager
+{
+private:
+    // Lock-free accumulators behind LockModeStats
+    struct ModeCounters
+    {
+        std::atomic<std::uint64_t> acquisitions{0};
+        std::atomic<std::uint64_t> totalWait{0};
+        std::atomic<std::uint64_t> totalHold{0};
+        std::atomic<std::uint64_t> maxHold{0};
+
+        LockModeStats snapshot() const
+        {
+            return {acquisitions.load(), totalWait.load(), totalHold.load(), maxHold.load()};
+        }
+    };
+
+    using Clock = std::chrono::steady_clock;
+
+    static std::uint64_t nanosSince(Clock::time_point start)
+    {
+        return static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+    }
+
+    // Records wait time on construction and hold time on destruction; declare it
+    // after the lock guard so it is destroyed (and stops timing) before the unlock
+    class HoldTimer
+    {
+    private:
+        ModeCounters &counters;
+        Clock::time_point acquired;
+
+    public:
+        HoldTimer(ModeCounters &c, Clock::time_point requested) : counters(c), acquired(Clock::now())
+        {
+            counters.acquisitions.fetch_add(1, std::memory_order_relaxed);
+            counters.totalWait.fetch_add(static_cast<std::uint64_t>(
+                                             std::chrono::duration_cast<std::chrono::nanoseconds>(acquired - requested).count()),
+                                         std::memory_order_relaxed);
+        }
+
+        ~HoldTimer()
+        {
+            std::uint64_t held = nanosSince(acquired);
+            counters.totalHold.fetch_add(held, std::memory_order_relaxed);
+            std::uint64_t previous = counters.maxHold.load(std::memory_order_relaxed);
+            while (held > previous && !counters.maxHold.compare_exchange_weak(previous, held, std::memory_order_relaxed))
+            {
+            }
+        }
+    };
+
+    // Mirrors every change into the ID map and the snapshot rows, which share
+    // one copy of each task (runs under the exclusive lock)
+    class ChangeMirror : public TaskObserver
+    {
+    private:
+        ConcurrentTaskMap &map;
+        SnapshotRows &regular;
+        SnapshotRows &urgent;
+
+    public:
+        ChangeMirror(ConcurrentTaskMap &m, SnapshotRows &r, SnapshotRows &u) : map(m), regular(r), urgent(u) {}
+
+        void taskStored(const Task &task, const TaskPlacement &placement) override
+        {
+            auto copy = std::make_shared<const Task>(task);
+            map.store(copy);
+            (placement.urgent ? urgent : regular).store(placement.row, {std::move(copy), placement.urgentRank});
+        }
+
+        void taskRemoved(TaskId id, const TaskPlacement &placement) override
+        {
+            map.remove(id);
+            (placement.urgent ? urgent : regular).swapRemove(placement.row);
+        }
+    };
+
+    MemoryMode memoryMode;
+    std::unique_ptr<TaskManager> manager;
+    ConcurrentTaskMap byId;
+    SnapshotRows regularRows;
+    SnapshotRows urgentRows;
+    ChangeMirror mirror{byId, regularRows, urgentRows};
+    mutable std::shared_mutex mutex;
+    mutable ModeCounters readCounters;
+    ModeCounters writeCounters;
+    std::shared_ptr<const TaskSnapshot> published; // Accessed only through atomic_load/atomic_store
+    std::uint64_t writes = 0;                      // Exclusive lock only
+
+    // Finish a write: shed dead memory and publish the new snapshot (exclusive lock held)
+    void afterWrite()
+    {
+        if (manager->shouldRebuild())
+        {
+            auto fresh = std::make_unique<TaskManager>(memoryMode);
+            manager->copyInto(*fresh);
+            manager = std::move(fresh);
+
+            // Urgent rows and ranks differ in the copy, so restate every task
+            regularRows.clear();
+            urgentRows.clear();
+            manager->setObserver(&mirror);
+            manager->announceTasks();
+        }
+
+        auto next = std::make_shared<const TaskSnapshot>(++writes, manager->getActiveOrder(),
+                                                         regularRows.share(), regularRows.size(),
+                                                         urgentRows.share(), urgentRows.size());
+        std::atomic_store(&published, std::move(next));
+    }
+
+public:
+    explicit SharedTaskManager(MemoryMode memoryMode = MemoryMode::Heap)
+        : memoryMode(memoryMode), manager(std::make_unique<TaskManager>(memoryMode)), published(std::make_shared<TaskSnapshot>())
+    {
+        manager->setObserver(&mirror);
+    }
+
+    SharedTaskManager(const SharedTaskManager &) = delete;
+    SharedTaskManager &operator=(const SharedTaskManager &) = delete;
+
+    // Run 'f' with shared (read-only) access; many readers may run at once
+    template <typename F>
+    decltype(auto) read(F &&f) const
+    {
+        Clock::time_point requested = Clock::now();
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        HoldTimer timer(readCounters, requested);
+        return f(static_cast<const TaskManager &>(*manager));
+    }
+
+    // Run 'f' with exclusive access for mutations, then publish a snapshot of the result
+    template <typename F>
+    decltype(auto) write(F &&f)
+    {
+        Clock::time_point requested = Clock::now();
+        std::unique_lock<std::shared_mutex> lock(mutex);
+        HoldTimer timer(writeCounters, requested);
+        if constexpr (std::is_void_v<std::invoke_result_t<F &, TaskManager &>>)
+        {
+            f(*manager);
+            afterWrite();
+        }
+        else
+        {
+            auto result = f(*manager);
+            afterWrite();
+            return result;
+        }
+    }
+
+    // Snapshot reflecting every completed write; takes no lock and never waits for writers
+    std::shared_ptr<const TaskSnapshot> snapshot() const
+    {
+        return std::atomic_load(&published);
+    }
+
+    // Call 'visit' with task 'id' if it exists; takes no lock and never waits for writers
+    template <typename Visitor>
+    bool readTask(TaskId id, Visitor visit) const
+    {
+        return byId.read(id, visit);
+    }
+
+    LockStats getLockStats() const
+    {
+        return {readCounters.snapshot(), writeCounters.snapshot()};
+    }
+};
+
+#endif // SHAREDTASKMANAGER_H
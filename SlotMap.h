@@ -0,0 +1,162 @@
+#ifndef SLOTMAP_H
+#define SLOTMAP_H
+
+#include <vector>
+#include <memory_resource>
+#include <cstdint>
+
+// Slot map: values live densely in a vector for fast iteration, while callers
+// hold stable handles (slot index + generation) that survive erases.
+// Erasing swaps the last value into the hole, so it costs O(1) instead of
+// shifting the tail like std::vector::erase. All three arrays allocate from the
+// memory resource given at construction.
+template <typename T>
+class SlotMap
+{
+public:
+    struct Handle
+    {
+        std::uint32_t index = 0;      // Slot number
+        std::uint32_t generation = 0; // Bumped each time the slot is freed
+
+        bool operator==(const Handle &other) const
+        {
+            return index == other.index && generation == other.generation;
+        }
+        bool operator!=(const Handle &other) const { return !(*this == other); }
+    };
+
+private:
+    static constexpr std::uint32_t npos = UINT32_MAX;
+
+    struct Slot
+    {
+        std::uint32_t dense;      // Position in values, or next free slot when unused
+        std::uint32_t generation; // Must match the handle's generation to be valid
+    };
+
+    std::pmr::vector<T> values;                  // Dense storage
+    std::pmr::vector<std::uint32_t> denseToSlot; // Back-pointer from dense position to slot
+    std::pmr::vector<Slot> slots;                // Handle index -> dense position
+    std::uint32_t freeHead = npos;          // Head of the free slot list
+
+    Handle allocateSlot()
+    {
+        std::uint32_t dense = static_cast<std::uint32_t>(values.size() - 1);
+        std::uint32_t index;
+        if (freeHead != npos)
+        {
+            index = freeHead;
+            freeHead = slots[index].dense;
+            slots[index].dense = dense;
+        }
+        else
+        {
+            index = static_cast<std::uint32_t>(slots.size());
+            slots.push_back({dense, 0});
+        }
+        denseToSlot.push_back(index);
+        return {index, slots[index].generation};
+    }
+
+public:
+    explicit SlotMap(std::pmr::memory_resource *resource = std::pmr::get_default_resource())
+        : values(resource), denseToSlot(resource), slots(resource)
+    {
+    }
+
+    Handle insert(const T &value)
+    {
+        values.push_back(value);
+        return allocateSlot();
+    }
+
+    Handle insert(T &&value)
+    {
+        values.push_back(std::move(value));
+        return allocateSlot();
+    }
+
+    bool contains(Handle h) const
+    {
+        return h.index < slots.size() && slots[h.index].generation == h.generation;
+    }
+
+    T *get(Handle h)
+    {
+        return contains(h) ? &values[slots[h.index].dense] : nullptr;
+    }
+
+    const T *get(Handle h) const
+    {
+        return contains(h) ? &values[slots[h.index].dense] : nullptr;
+    }
+
+    // Remove the value behind a handle in O(1); the last value moves into its place
+    bool erase(Handle h)
+    {
+        if (!contains(h))
+            return false;
+
+        std::uint32_t dense = slots[h.index].dense;
+        std::uint32_t last = static_cast<std::uint32_t>(values.size() - 1);
+        if (dense != last)
+        {
+            values[dense] = std::move(values[last]);
+            denseToSlot[dense] = denseToSlot[last];
+            slots[denseToSlot[dense]].dense = dense;
+        }
+        values.pop_back();
+        denseToSlot.pop_back();
+
+        ++slots[h.index].generation;
+        slots[h.index].dense = freeHead;
+        freeHead = h.index;
+        return true;
+    }
+
+    // Dense position of a live handle (check contains() first)
+    size_t indexOf(Handle h) const
+    {
+        return slots[h.index].dense;
+    }
+
+    // Handle of the value at a dense position
+    Handle handleAt(size_t dense) const
+    {
+        std::uint32_t index = denseToSlot[dense];
+        return {index, slots[index].generation};
+    }
+
+    void reserve(size_t n)
+    {
+        values.reserve(n);
+        denseToSlot.reserve(n);
+        slots.reserve(n);
+    }
+
+    void clear()
+    {
+        for (std::uint32_t index : denseToSlot)
+        {
+            ++slots[index].generation;
+            slots[index].dense = freeHead;
+            freeHead = index;
+        }
+        values.clear();
+        denseToSlot.clear();
+    }
+
+    // Dense access and iteration
+    T &operator[](size_t dense) { return values[dense]; }
+    const T &operator[](size_t dense) const { return values[dense]; }
+    size_t size() const { return values.size(); }
+    bool empty() const { return values.empty(); }
+
+    typename std::pmr::vector<T>::iterator begin() { return values.begin(); }
+    typename std::pmr::vector<T>::iterator end() { return values.end(); }
+    typename std::pmr::vector<T>::const_iterator begin() const { return values.begin(); }
+    typename std::pmr::vector<T>::const_iterator end() const { return values.end(); }
+};
+
+#endif // SLOTMAP_H
@@ -0,0 +1,190 @@
+#ifndef STRINGARENA_H
+#define STRINGARENA_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory_resource>
+#include <stdexcept>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Storage for many short strings, carved out of chunks that double from 4 KiB
+// up to 1 MiB, so a small arena stays small. Each string is kept as a 32-bit
+// length followed by its bytes, padded to 8, and is named by a 32-bit Ref (chunk
+// number in the high bits, offset in the low 20), so a record can refer to a
+// string in four bytes instead of owning a 32-byte std::string plus a heap
+// block. Chunks never move, so views stay valid until the string is released
+// or the arena cleared. A released slot goes on a free list for its size and
+// is reused by the next string of that size; chunks themselves go back to the
+// resource only on clear(). Refs address up to 4096 chunks, taken from the
+// memory resource given at construction; store() throws std::length_error
+// rather than hand out a Ref past the last one.
+class StringArena
+{
+public:
+    using Ref = std::uint32_t;
+
+    static constexpr unsigned OFFSET_BITS = 20;
+    static constexpr size_t CHUNK_SIZE = size_t(1) << OFFSET_BITS;
+    static constexpr size_t MAX_CHUNKS = size_t(1) << (32 - OFFSET_BITS);
+    static constexpr size_t FIRST_CHUNK_SIZE = 4096;
+    static constexpr size_t SLOT_ALIGNMENT = 8; // Room for the length and a free-list link
+
+private:
+    struct Chunk
+    {
+        char *data;
+        size_t size;
+    };
+
+    std::pmr::memory_resource *resource;
+    std::pmr::vector<Chunk> chunks;
+    size_t chunkUsed = 0;     // Bytes used in the last chunk
+    size_t chunkCapacity = 0; // Size of the last chunk; 0 until one exists or after an oversized string
+    size_t nextChunkSize = FIRST_CHUNK_SIZE;
+    size_t usedBytes = 0;
+    size_t reservedBytes = 0;
+
+    // Footprint -> last released slot of that size. A free slot keeps its length
+    // and holds the Ref of the next free slot of the same size (or NO_SLOT).
+    static constexpr Ref NO_SLOT = UINT32_MAX;
+    std::pmr::unordered_map<size_t, Ref> freeSlots;
+
+    char *newChunk(size_t size)
+    {
+        if (chunks.size() == MAX_CHUNKS)
+            throw std::length_error("StringArena: no Refs left for another chunk");
+        char *data = static_cast<char *>(resource->allocate(size, alignof(std::uint32_t)));
+        chunks.push_back({data, size});
+        reservedBytes += size;
+        return data;
+    }
+
+    char *locate(Ref ref) const
+    {
+        return chunks[ref >> OFFSET_BITS].data + (ref & (CHUNK_SIZE - 1));
+    }
+
+    // Take a released slot of exactly 'needed' bytes, if there is one
+    bool reuseSlot(size_t needed, Ref &ref)
+    {
+        auto it = freeSlots.find(needed);
+        if (it == freeSlots.end())
+            return false;
+
+        ref = it->second;
+        Ref next;
+        std::memcpy(&next, locate(ref) + sizeof(std::uint32_t), sizeof(next));
+        if (next == NO_SLOT)
+            freeSlots.erase(it);
+        else
+            it->second = next;
+        return true;
+    }
+
+public:
+    explicit StringArena(std::pmr::memory_resource *resource = std::pmr::get_default_resource())
+        : resource(resource), chunks(resource), freeSlots(resource)
+    {
+    }
+
+    StringArena(const StringArena &) = delete;
+    StringArena &operator=(const StringArena &) = delete;
+
+    ~StringArena()
+    {
+        clear();
+    }
+
+    // Bytes a string of this length takes in the arena
+    static constexpr size_t footprint(size_t length)
+    {
+        return (sizeof(std::uint32_t) + length + SLOT_ALIGNMENT - 1) & ~(SLOT_ALIGNMENT - 1);
+    }
+
+    Ref store(std::string_view text)
+    {
+        size_t needed = footprint(text.size());
+        std::uint32_t length = static_cast<std::uint32_t>(text.size());
+        Ref reused;
+        if (reuseSlot(needed, reused))
+        {
+            char *at = locate(reused);
+            std::memcpy(at, &length, sizeof(length));
+            std::memcpy(at + sizeof(length), text.data(), text.size());
+            usedBytes += needed;
+            return reused;
+        }
+
+        char *at;
+        if (needed > CHUNK_SIZE)
+        {
+            // Oversized strings get a chunk of their own; later strings start a fresh one
+            at = newChunk(needed);
+            chunkUsed = 0;
+            chunkCapacity = 0;
+        }
+        else
+        {
+            if (chunkUsed + needed > chunkCapacity)
+            {
+                size_t size = nextChunkSize;
+                while (size < needed)
+                    size *= 2;
+                newChunk(size);
+                chunkUsed = 0;
+                chunkCapacity = size;
+                nextChunkSize = std::min(size * 2, CHUNK_SIZE);
+            }
+            at = chunks.back().data + chunkUsed;
+        }
+
+        Ref ref = static_cast<Ref>(((chunks.size() - 1) << OFFSET_BITS) | (at - chunks.back().data));
+        std::memcpy(at, &length, sizeof(length));
+        std::memcpy(at + sizeof(length), text.data(), text.size());
+        if (needed <= CHUNK_SIZE)
+            chunkUsed += needed;
+        usedBytes += needed;
+        return ref;
+    }
+
+    std::string_view view(Ref ref) const
+    {
+        const char *at = locate(ref);
+        std::uint32_t length;
+        std::memcpy(&length, at, sizeof(length));
+        return std::string_view(at + sizeof(length), length);
+    }
+
+    // Give a string's slot back for reuse; its Ref and views become invalid
+    void release(Ref ref)
+    {
+        size_t size = footprint(view(ref).size());
+        auto it = freeSlots.find(size);
+        Ref next = it != freeSlots.end() ? it->second : NO_SLOT;
+        std::memcpy(locate(ref) + sizeof(std::uint32_t), &next, sizeof(next));
+        freeSlots[size] = ref;
+        usedBytes -= size;
+    }
+
+    void clear()
+    {
+        freeSlots.clear();
+        for (const Chunk &chunk : chunks)
+            resource->deallocate(chunk.data, chunk.size, alignof(std::uint32_t));
+        chunks.clear();
+        chunks.shrink_to_fit();
+        chunkUsed = 0;
+        chunkCapacity = 0;
+        nextChunkSize = FIRST_CHUNK_SIZE;
+        usedBytes = 0;
+        reservedBytes = 0;
+    }
+
+    size_t bytesUsed() const { return usedBytes; }
+    size_t bytesReserved() const { return reservedBytes; }
+};
+
+#endif // STRINGARENA_H
@@ -0,0 +1,106 @@
+#ifndef STRINGPOOL_H
+#define STRINGPOOL_H
+
+#include <string_view>
+#include <unordered_map>
+#include <memory_resource>
+#include "StringArena.h"
+
+// StringArena with optional interning. intern() returns the same Ref for equal
+// text, so repeated strings share one copy and equality becomes a Ref compare;
+// store() always adds a copy (for text that rarely repeats, such as descriptions).
+// Interned strings are reference counted: every intern() takes a reference and
+// release() drops one, freeing the text when the last goes. clear() frees
+// everything at once.
+class StringPool
+{
+public:
+    using Ref = StringArena::Ref;
+
+private:
+    struct Entry
+    {
+        Ref ref;
+        size_t references;
+    };
+
+    StringArena arena;
+    std::pmr::unordered_map<std::string_view, Entry> interned; // Keys view into the arena
+
+public:
+    explicit StringPool(std::pmr::memory_resource *resource = std::pmr::get_default_resource())
+        : arena(resource), interned(resource)
+    {
+    }
+
+    StringPool(const StringPool &) = delete;
+    StringPool &operator=(const StringPool &) = delete;
+
+    Ref intern(std::string_view text)
+    {
+        auto it = interned.find(text);
+        if (it != interned.end())
+        {
+            ++it->second.references;
+            return it->second.ref;
+        }
+
+        Ref ref = arena.store(text);
+        interned.emplace(arena.view(ref), Entry{ref, 1});
+        return ref;
+    }
+
+    // Drop one reference taken by intern(); the text is freed with the last one
+    void release(Ref ref)
+    {
+        auto it = interned.find(arena.view(ref));
+        if (it == interned.end() || --it->second.references > 0)
+            return;
+
+        interned.erase(it);
+        arena.release(ref);
+    }
+
+    // Ref of already-interned text, without adding it
+    bool find(std::string_view text, Ref &ref) const
+    {
+        auto it = interned.find(text);
+        if (it == interned.end())
+            return false;
+
+        ref = it->second.ref;
+        return true;
+    }
+
+    Ref store(std::string_view text)
+    {
+        return arena.store(text);
+    }
+
+    std::string_view view(Ref ref) const
+    {
+        return arena.view(ref);
+    }
+
+    void reserve(size_t distinctStrings)
+    {
+        interned.reserve(distinctStrings);
+    }
+
+    void clear()
+    {
+        interned.clear();
+        arena.clear();
+    }
+
+    size_t internedCount() const { return interned.size(); }
+
+    // Arena chunks plus an estimate of the intern table (nodes and buckets)
+    size_t bytesReserved() const
+    {
+        size_t nodeBytes = sizeof(void *) + sizeof(size_t) + sizeof(std::string_view) + sizeof(Entry);
+        return arena.bytesReserved() + interned.size() * nodeBytes + interned.bucket_count() * sizeof(void *);
+    }
+};
+
+#endif // STRINGPOOL_H
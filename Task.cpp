@@ -1,10 +1,4 @@
-<<<<<<< HEAD
 #include "Task.h"
 
 // Define the static member variable
-=======
-#include "Task.h"
-
-// Define the static member variable
->>>>>>> 31e08e23f34c54259e619d4f92b64e13a13828aa
-int Task::nextId = 1;
\ No newline at end of file
+TaskIdAllocator Task::idAllocator;
\ No newline at end of file
@@ -1,4 +1,3 @@
-<<<<<<< HEAD
 #ifndef TASK_H
 #define TASK_H
 
@@ -7,154 +6,140 @@
 #include <iostream>
 #include <sstream>
 #include <iomanip>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include "CivilDate.h"
+#include "TaskIdAllocator.h"
 
 class Task
 {
 private:
-    static int nextId;
-    int id;
+    static TaskIdAllocator idAllocator;
+    TaskId id;
     std::string title;
     std::string description;
     bool completed;
-    std::chrono::system_clock::time_point dueDate;
+    std::int32_t dueDay; // Due date as days since 1970-01-01 (see CivilDate.h)
     int priority;
 
+    // Keeps an existing ID instead of drawing a new one (see restore)
+    Task(TaskId existingId, std::string t, std::string desc, std::int32_t due, int prio, bool done)
+        : id(existingId), title(std::move(t)), description(std::move(desc)), completed(done), dueDay(due), priority(prio) {}
+
 public:
-    Task(const std::string &t, const std::string &desc, const std::chrono::system_clock::time_point &due, int prio)
-        : id(nextId++), title(t), description(desc), completed(false), dueDate(due), priority(prio) {}
+    // Priorities the board accepts (the form offers 1-5)
+    static constexpr int MIN_PRIORITY = 1;
+    static constexpr int MAX_PRIORITY = 5;
 
-    // Getters
-    int getId() const { return id; }
-    std::string getTitle() const { return title; }
-    std::string getDescription() const { return description; }
-    bool isCompleted() const { return completed; }
-    std::chrono::system_clock::time_point getDueDate() const { return dueDate; }
-    int getPriority() const { return priority; }
+    // Strings are taken by value so callers can move them in
+    Task(std::string t, std::string desc, const std::chrono::system_clock::time_point &due, int prio)
+        : id(idAllocator.next()), title(std::move(t)), description(std::move(desc)), completed(false), dueDay(daysFromTimePoint(due)), priority(prio) {}
 
-    // Setters
-    void setTitle(const std::string &t) { title = t; }
-    void setDescription(const std::string &desc) { description = desc; }
-    void setCompleted(bool status) { completed = status; }
-    void setDueDate(const std::chrono::system_clock::time_point &due) { dueDate = due; }
-    void setPriority(int prio) { priority = prio; }
+    Task(std::string t, std::string desc, std::int32_t due, int prio)
+        : id(idAllocator.next()), title(std::move(t)), description(std::move(desc)), completed(false), dueDay(due), priority(prio) {}
 
-    // Helper method to format date as string
-    std::string getDueDateString() const
+    // Rebuild a task that already has an ID, e.g. from compact storage
+    static Task restore(TaskId id, std::string t, std::string desc, std::int32_t due, int prio, bool done)
     {
-        std::time_t time = std::chrono::system_clock::to_time_t(dueDate);
-        std::tm *tm = std::localtime(&time);
-        std::ostringstream oss;
-        oss << std::put_time(tm, "%Y-%m-%d");
-        return oss.str();
-    }
-
-    // Convert to JSON string for API
-    std::string toJson() const
-    {
-        std::ostringstream json;
-        json << "{"
-             << "\"id\":" << id << ","
-             << "\"title\":\"" << title << "\","
-             << "\"description\":\"" << description << "\","
-             << "\"completed\":" << (completed ? "true" : "false") << ","
-             << "\"dueDate\":\"" << getDueDateString() << "\","
-             << "\"priority\":" << priority
-             << "}";
-        return json.str();
-    }
-
-    // Display task information
-    void display() const
-    {
-        std::time_t time = std::chrono::system_clock::to_time_t(dueDate);
-        std::cout << "ID: " << id << "\n"
-                  << "Title: " << title << "\n"
-                  << "Description: " << description << "\n"
-                  << "Status: " << (completed ? "Completed" : "Pending") << "\n"
-                  << "Due Date: " << std::ctime(&time)
-                  << "Priority: " << priority << "\n"
-                  << "------------------------\n";
+        return Task(id, std::move(t), std::move(desc), due, prio, done);
     }
-};
 
-=======
-#ifndef TASK_H
-#define TASK_H
+    // Process-wide ID source, e.g. to enable persistence at startup
+    static TaskIdAllocator &ids() { return idAllocator; }
 
-#include <string>
-#include <chrono>
-#include <iostream>
-#include <sstream>
-#include <iomanip>
-
-class Task
-{
-private:
-    static int nextId;
-    int id;
-    std::string title;
-    std::string description;
-    bool completed;
-    std::chrono::system_clock::time_point dueDate;
-    int priority;
-
-public:
-    Task(const std::string &t, const std::string &desc, const std::chrono::system_clock::time_point &due, int prio)
-        : id(nextId++), title(t), description(desc), completed(false), dueDate(due), priority(prio) {}
-
-    // Getters
-    int getId() const { return id; }
-    std::string getTitle() const { return title; }
-    std::string getDescription() const { return description; }
+    // Getters (strings by reference: reading a field never allocates)
+    TaskId getId() const { return id; }
+    const std::string &getTitle() const { return title; }
+    const std::string &getDescription() const { return description; }
     bool isCompleted() const { return completed; }
-    std::chrono::system_clock::time_point getDueDate() const { return dueDate; }
+    std::chrono::system_clock::time_point getDueDate() const { return timePointFromDays(dueDay); }
+    std::int32_t getDueDay() const { return dueDay; }
     int getPriority() const { return priority; }
 
     // Setters
     void setTitle(const std::string &t) { title = t; }
     void setDescription(const std::string &desc) { description = desc; }
     void setCompleted(bool status) { completed = status; }
-    void setDueDate(const std::chrono::system_clock::time_point &due) { dueDate = due; }
+    void setDueDate(const std::chrono::system_clock::time_point &due) { dueDay = daysFromTimePoint(due); }
+    void setDueDay(std::int32_t due) { dueDay = due; }
     void setPriority(int prio) { priority = prio; }
 
-    // Helper method to format date as string
+    // Write the due date as "YYYY-MM-DD" into a caller buffer of ISO_DATE_LENGTH chars
+    void formatDueDate(char *out) const
+    {
+        formatIsoDate(dueDay, out);
+    }
+
+    // Helper method to format date as string (short enough to stay in the small-string buffer)
     std::string getDueDateString() const
     {
-        std::time_t time = std::chrono::system_clock::to_time_t(dueDate);
-        std::tm *tm = std::localtime(&time);
-        std::ostringstream oss;
-        oss << std::put_time(tm, "%Y-%m-%d");
-        return oss.str();
+        char buffer[ISO_DATE_LENGTH];
+        formatIsoDate(dueDay, buffer);
+        return std::string(buffer, ISO_DATE_LENGTH);
+    }
+
+    // Call visit(name, value) for every field in a fixed order, without copying:
+    // id as TaskId, title/description/dueDate as std::string_view, completed as
+    // bool and priority as int. The dueDate view is only valid during the call.
+    template <typename Visitor>
+    void visitFields(Visitor &&visit) const
+    {
+        char due[ISO_DATE_LENGTH];
+        formatIsoDate(dueDay, due);
+
+        visit("id", id);
+        visit("title", std::string_view(title));
+        visit("description", std::string_view(description));
+        visit("completed", completed);
+        visit("dueDate", std::string_view(due, ISO_DATE_LENGTH));
+        visit("priority", priority);
     }
 
     // Convert to JSON string for API
     std::string toJson() const
     {
-        std::ostringstream json;
-        json << "{"
-             << "\"id\":" << id << ","
-             << "\"title\":\"" << title << "\","
-             << "\"description\":\"" << description << "\","
-             << "\"completed\":" << (completed ? "true" : "false") << ","
-             << "\"dueDate\":\"" << getDueDateString() << "\","
-             << "\"priority\":" << priority
-             << "}";
-        return json.str();
+        std::string json;
+        json.reserve(96 + title.size() + description.size());
+        json += '{';
+        visitFields([&json](const char *name, const auto &value)
+                    {
+            using Value = std::decay_t<decltype(value)>;
+            if (json.size() > 1)
+                json += ',';
+            json += '"';
+            json += name;
+            json += "\":";
+            if constexpr (std::is_same_v<Value, std::string_view>)
+            {
+                json += '"';
+                json += value;
+                json += '"';
+            }
+            else if constexpr (std::is_same_v<Value, bool>)
+            {
+                json += value ? "true" : "false";
+            }
+            else
+            {
+                json += std::to_string(value);
+            } });
+        json += '}';
+        return json;
     }
 
     // Display task information
     void display() const
     {
-        std::time_t time = std::chrono::system_clock::to_time_t(dueDate);
         std::cout << "ID: " << id << "\n"
                   << "Title: " << title << "\n"
                   << "Description: " << description << "\n"
                   << "Status: " << (completed ? "Completed" : "Pending") << "\n"
-                  << "Due Date: " << std::ctime(&time)
+                  << "Due Date: " << getDueDateString() << "\n"
                   << "Priority: " << priority << "\n"
                   << "------------------------\n";
     }
 };
 
->>>>>>> 31e08e23f34c54259e619d4f92b64e13a13828aa
 #endif // TASK_H
\ No newline at end of file
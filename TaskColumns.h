@@ -0,0 +1,64 @@
+#ifndef TASKCOLUMNS_H
+#define TASKCOLUMNS_H
+
+#include <memory_resource>
+#include <cstdint>
+#include "Task.h"
+#include "BitColumn.h"
+
+// Bit-packed flag columns of the Task records. Row i describes the task at
+// dense position i of the owning SlotMap, so counts and filters over a flag
+// read 64 rows per word instead of walking whole Task records. Due-date
+// queries go through TaskManager's dueIndex rather than a column scan.
+class TaskColumns
+{
+public:
+    using DueDay = std::int32_t;
+
+    // Priority at which a task counts as high priority in 'highPriority'
+    static constexpr int HIGH_PRIORITY = 4;
+
+    BitColumn completed;
+    BitColumn highPriority; // priority >= HIGH_PRIORITY
+
+    explicit TaskColumns(std::pmr::memory_resource *resource = std::pmr::get_default_resource())
+        : completed(resource), highPriority(resource)
+    {
+    }
+
+    size_t size() const { return completed.size(); }
+
+    void reserve(size_t n)
+    {
+        completed.reserve(n);
+        highPriority.reserve(n);
+    }
+
+    void clear()
+    {
+        completed.clear();
+        highPriority.clear();
+    }
+
+    void push_back(const Task &task)
+    {
+        completed.push_back(task.isCompleted());
+        highPriority.push_back(task.getPriority() >= HIGH_PRIORITY);
+    }
+
+    // Refresh row i after the matching record changed
+    void set(size_t i, const Task &task)
+    {
+        completed.set(i, task.isCompleted());
+        highPriority.set(i, task.getPriority() >= HIGH_PRIORITY);
+    }
+
+    // Mirror SlotMap::erase: the last row moves into the hole
+    void swapRemove(size_t i)
+    {
+        completed.swapRemove(i);
+        highPriority.swapRemove(i);
+    }
+};
+
+#endif // TASKCOLUMNS_H
@@ -0,0 +1,196 @@
+#ifndef TASKCOMMANDACTOR_H
+#define TASKCOMMANDACTOR_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "MpscQueue.h"
+#include "SharedTaskManager.h"
+
+// Single-writer mode: connection threads submit mutations instead of taking a
+// board's write lock themselves, and one owner thread applies them.
+//
+// The owner drains up to MAX_BATCH commands at a time and applies all commands
+// for the same board inside one write(), so a burst of posts costs one lock
+// acquisition and one snapshot publication instead of one per request.
+// Commands for a board run in submission order. Each command's future completes
+// after its batch has been written, so a caller that waits can read its own write.
+class TaskCommandActor
+{
+public:
+    using Mutation = std::function<void(TaskManager &)>;
+
+    static constexpr size_t QUEUE_CAPACITY = 1024;
+    static constexpr size_t MAX_BATCH = 64;
+
+    struct Stats
+    {
+        std::uint64_t commands = 0;
+        std::uint64_t batches = 0;
+        std::uint64_t boardWrites = 0; // write() calls; less than commands when batching helps
+
+        std::string toJson() const
+        {
+            return "{\"commands\":" + std::to_string(commands) +
+                   ",\"batches\":" + std::to_string(batches) +
+                   ",\"boardWrites\":" + std::to_string(boardWrites) + "}";
+        }
+    };
+
+private:
+    struct Command
+    {
+        SharedTaskManager *board = nullptr;
+        Mutation apply;
+        std::promise<void> done;
+    };
+
+    MpscQueue<Command> queue;
+    std::atomic<bool> running{true};
+    std::atomic<bool> idle{false}; // Owner is (about to be) asleep on 'wake'
+    std::mutex wakeMutex;
+    std::condition_variable wake;
+    std::atomic<std::uint64_t> commandCount{0};
+    std::atomic<std::uint64_t> batchCount{0};
+    std::atomic<std::uint64_t> boardWriteCount{0};
+    std::thread owner; // Last, so everything above exists before it starts
+
+    void run()
+    {
+        std::vector<Command> batch;
+        batch.reserve(MAX_BATCH);
+
+        for (;;)
+        {
+            Command command;
+            while (batch.size() < MAX_BATCH && queue.tryPop(command))
+            {
+                batch.push_back(std::move(command));
+            }
+
+            if (batch.empty())
+            {
+                if (!running.load())
+                    return;
+
+                // Announce 'idle', then look at the queue again before sleeping.
+                // submit() pushes, then reads 'idle'; with a seq_cst fence on each
+                // side at least one of them sees the other, so either the predicate
+                // finds the command or the producer sees 'idle' and notifies. The
+                // producer notifies under wakeMutex, which is held from here until
+                // wait() sleeps, so the notification cannot slip in between.
+                std::unique_lock<std::mutex> lock(wakeMutex);
+                idle.store(true);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                wake.wait(lock, [this]
+                          { return !queue.empty() || !running.load(); });
+                idle.store(false);
+                continue;
+            }
+
+            applyBatch(batch);
+            batch.clear();
+        }
+    }
+
+    void applyBatch(std::vector<Command> &batch)
+    {
+        std::vector<std::exception_ptr> errors(batch.size());
+        std::vector<bool> applied(batch.size(), false);
+
+        // One write() per distinct board, in order of first appearance
+        for (size_t first = 0; first < batch.size(); ++first)
+        {
+            if (applied[first])
+                continue;
+
+            SharedTaskManager *board = batch[first].board;
+            board->write([&](TaskManager &tasks)
+                         {
+                for (size_t i = first; i < batch.size(); ++i)
+                {
+                    if (applied[i] || batch[i].board != board)
+                        continue;
+
+                    applied[i] = true;
+                    try
+                    {
+                        batch[i].apply(tasks);
+                    }
+                    catch (...)
+                    {
+                        errors[i] = std::current_exception();
+                    }
+                } });
+            boardWriteCount.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        // Only now does every board's snapshot() reflect the changes
+        for (size_t i = 0; i < batch.size(); ++i)
+        {
+            if (errors[i])
+                batch[i].done.set_exception(errors[i]);
+            else
+                batch[i].done.set_value();
+        }
+        commandCount.fetch_add(batch.size(), std::memory_order_relaxed);
+        batchCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+public:
+    TaskCommandActor() : queue(QUEUE_CAPACITY), owner(&TaskCommandActor::run, this)
+    {
+    }
+
+    // Finishes every command already submitted before returning
+    ~TaskCommandActor()
+    {
+        running.store(false);
+        {
+            std::lock_guard<std::mutex> lock(wakeMutex);
+            wake.notify_one();
+        }
+        owner.join();
+    }
+
+    TaskCommandActor(const TaskCommandActor &) = delete;
+    TaskCommandActor &operator=(const TaskCommandActor &) = delete;
+
+    // Queue a mutation for 'board'; when the queue is full the caller yields until
+    // there is room, which pushes back on connection threads under overload
+    std::future<void> submit(SharedTaskManager &board, Mutation apply)
+    {
+        Command command;
+        command.board = &board;
+        command.apply = std::move(apply);
+        std::future<void> result = command.done.get_future();
+
+        while (!queue.tryPush(command))
+        {
+            std::this_thread::yield();
+        }
+
+        // Pairs with the fence in run()
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (idle.load())
+        {
+            std::lock_guard<std::mutex> lock(wakeMutex);
+            wake.notify_one();
+        }
+        return result;
+    }
+
+    Stats getStats() const
+    {
+        return {commandCount.load(), batchCount.load(), boardWriteCount.load()};
+    }
+};
+
+#endif // TASKCOMMANDACTOR_H
@@ -0,0 +1,171 @@
+#ifndef TASKHTML_H
+#define TASKHTML_H
+
+#include <charconv>
+#include <string>
+#include <string_view>
+#include "Task.h"
+
+// Kanban board markup for the web frontend. Rendering appends straight into one
+// pre-sized std::string: fields are read by reference, numbers and dates are
+// formatted into stack buffers, so a render makes no per-task allocations.
+class TaskHtml
+{
+public:
+    // Tasks at or above this priority go in the urgent column
+    static constexpr int URGENT_COLUMN_PRIORITY = 4;
+
+    // Fixed markup per card, excluding title and description
+    static constexpr size_t CARD_OVERHEAD = 600;
+
+    template <typename Integer>
+    static void appendNumber(std::string &html, Integer value)
+    {
+        char digits[24];
+        auto result = std::to_chars(digits, digits + sizeof(digits), value);
+        html.append(digits, result.ptr);
+    }
+
+    // Ranges handed to renderBoard may hold tasks or pointers to them
+    static const Task &deref(const Task *task) { return *task; }
+
+    template <typename TaskLike>
+    static const TaskLike &deref(const TaskLike &task) { return task; }
+
+    // 'task' is a Task or anything with the same read accessors
+    template <typename TaskLike>
+    static void appendTaskCard(std::string &html, const TaskLike &task, std::string_view cardClass)
+    {
+        char due[ISO_DATE_LENGTH];
+        task.formatDueDate(due);
+
+        html += "<div class=\"task-card ";
+        html += cardClass;
+        html += "\">";
+        html += "<div class=\"task-header\">";
+        html += "<h4>";
+        html += task.getTitle();
+        html += "</h4>";
+        html += "<span class=\"priority priority-";
+        appendNumber(html, task.getPriority());
+        html += "\">P";
+        appendNumber(html, task.getPriority());
+        html += "</span>";
+        html += "</div>";
+        html += "<p class=\"task-description\">";
+        html += task.getDescription();
+        html += "</p>";
+        html += "<div class=\"task-meta\">";
+        html += "<span class=\"due-date\">📅 ";
+        html.append(due, ISO_DATE_LENGTH);
+        html += "</span>";
+        html += "<span class=\"status ";
+        html += task.isCompleted() ? "completed" : "pending";
+        html += "\">";
+        html += task.isCompleted() ? "✅ Done" : "⏳ Active";
+        html += "</span>";
+        html += "</div>";
+        html += "<div class=\"task-actions\">";
+        if (!task.isCompleted())
+        {
+            html += "<button hx-post=\"complete-task\" hx-vals='{\"id\":";
+            appendNumber(html, task.getId());
+            html += "}' hx-target=\"#task-list\" class=\"action-btn complete-btn\">✓ Complete</button>";
+        }
+        html += "<button hx-post=\"delete-task\" hx-vals='{\"id\":";
+        appendNumber(html, task.getId());
+        html += "}' hx-target=\"#task-list\" class=\"action-btn delete-btn\">🗑️ Delete</button>";
+        html += "</div>";
+        html += "</div>";
+    }
+
+    // Render the whole board, splitting the columns by priority. 'tasks' is any
+    // sized range of tasks or task pointers, such as a std::vector<Task> or the
+    // listing of a TaskSnapshot.
+    template <typename Tasks>
+    static std::string renderBoard(const Tasks &tasks)
+    {
+        size_t urgentCount = 0;
+        size_t textBytes = 0;
+        for (const auto &item : tasks)
+        {
+            const auto &task = deref(item);
+            if (task.getPriority() >= URGENT_COLUMN_PRIORITY)
+                ++urgentCount;
+            textBytes += task.getTitle().size() + task.getDescription().size();
+        }
+        size_t regularCount = tasks.size() - urgentCount;
+
+        std::string html;
+        html.reserve(2048 + tasks.size() * CARD_OVERHEAD + textBytes);
+
+        html += "<div id=\"task-list\" class=\"kanban-board\">";
+
+        // Kanban columns container
+        html += "<div class=\"kanban-columns\">";
+
+        // Urgent tasks column
+        html += "<div class=\"kanban-column urgent-column\">";
+        html += "<div class=\"column-header urgent-header\">";
+        html += "<h3>🚨 Urgent Tasks</h3>";
+        html += "<span class=\"container-type\">(using std::deque)</span>";
+        html += "<span class=\"task-count\">";
+        appendNumber(html, urgentCount);
+        html += " tasks</span>";
+        html += "</div>";
+        html += "<div class=\"column-content\">";
+
+        if (urgentCount > 0)
+        {
+            for (const auto &item : tasks)
+            {
+                const auto &task = deref(item);
+                if (task.getPriority() >= URGENT_COLUMN_PRIORITY)
+                    appendTaskCard(html, task, "urgent-task");
+            }
+        }
+        else
+        {
+            html += "<div class=\"empty-column\">No urgent tasks</div>";
+        }
+        html += "</div></div>";
+
+        // Regular tasks column
+        html += "<div class=\"kanban-column regular-column\">";
+        html += "<div class=\"column-header regular-header\">";
+        html += "<h3>📝 Regular Tasks</h3>";
+        html += "<span class=\"container-type\">(using std::vector)</span>";
+        html += "<span class=\"task-count\">";
+        appendNumber(html, regularCount);
+        html += " tasks</span>";
+        html += "</div>";
+        html += "<div class=\"column-content\">";
+
+        if (regularCount > 0)
+        {
+            for (const auto &item : tasks)
+            {
+                const auto &task = deref(item);
+                if (task.getPriority() < URGENT_COLUMN_PRIORITY)
+                    appendTaskCard(html, task, "regular-task");
+            }
+        }
+        else
+        {
+            html += "<div class=\"empty-column\">No regular tasks</div>";
+        }
+        html += "</div></div>";
+
+        html += "</div>"; // Close kanban-columns
+
+        if (tasks.empty())
+        {
+            html += "<div class=\"no-tasks\">🎯 Your Kanban board is empty! Add your first task above to get started.</div>";
+        }
+
+        html += "</div>"; // Close kanban-board
+        return html;
+    }
+};
+
+#endif // TASKHTML_H
@@ -0,0 +1,190 @@
+#ifndef TASKIDALLOCATOR_H
+#define TASKIDALLOCATOR_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <system_error>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using TaskId = std::uint64_t;
+
+// Hands out unique 64-bit task IDs from any number of threads.
+//
+// Each thread grabs a block of IDs with a single atomic fetch_add and then
+// serves IDs from that block without touching shared state, so the shared
+// counter is hit once per BLOCK_SIZE tasks. IDs are unique but only increase
+// within a thread; they do not reflect global creation order.
+//
+// With persistence enabled, the allocator records a high-water mark ahead of
+// the IDs it hands out (PERSIST_STRIDE at a time). After a restart or crash it
+// resumes above that mark, so an ID is never issued twice. The file is
+// replaced atomically (write a temporary, sync it, rename it over the old one),
+// so a crash mid-update leaves the previous mark rather than a torn file. If a
+// later update fails, persistence is turned off with a single warning.
+class TaskIdAllocator
+{
+public:
+    static constexpr TaskId BLOCK_SIZE = 1024;
+    static constexpr TaskId PERSIST_STRIDE = BLOCK_SIZE * 1024;
+
+private:
+    struct ThreadBlock
+    {
+        const TaskIdAllocator *owner = nullptr;
+        std::uint64_t generation = 0; // Allocator generation the block was taken from
+        TaskId next = 0;
+        TaskId end = 0;
+    };
+
+    std::atomic<TaskId> nextBlockStart{1};         // First ID of the next unclaimed block
+    std::atomic<std::uint64_t> generation{0};      // Bumped by resumeFrom to invalidate thread blocks
+    std::atomic<TaskId> persistedMark{UINT64_MAX}; // IDs below this are covered (everything when off)
+    std::mutex persistMutex;
+    std::string persistPath; // Empty when persistence is off
+
+    static ThreadBlock &threadBlock()
+    {
+        static thread_local ThreadBlock block;
+        return block;
+    }
+
+    // Flush a written file's data to disk
+    static bool syncFile(std::FILE *file)
+    {
+#ifdef _WIN32
+        return _commit(_fileno(file)) == 0;
+#else
+        return fsync(fileno(file)) == 0;
+#endif
+    }
+
+    // Make a rename inside 'directory' durable (Windows commits it with the file)
+    static void syncDirectory(const std::filesystem::path &directory)
+    {
+#ifndef _WIN32
+        int fd = open(directory.empty() ? "." : directory.c_str(), O_RDONLY);
+        if (fd >= 0)
+        {
+            fsync(fd);
+            close(fd);
+        }
+#else
+        (void)directory;
+#endif
+    }
+
+    // Replace the state file with one holding 'mark' (persistMutex held)
+    bool writeMark(TaskId mark)
+    {
+        std::string tempPath = persistPath + ".tmp";
+        std::FILE *out = std::fopen(tempPath.c_str(), "w");
+        if (!out)
+            return false;
+
+        bool written = std::fprintf(out, "%llu\n", static_cast<unsigned long long>(mark)) > 0 &&
+                       std::fflush(out) == 0 && syncFile(out);
+        written = std::fclose(out) == 0 && written;
+
+        std::error_code error;
+        if (written)
+            std::filesystem::rename(tempPath, persistPath, error);
+        if (!written || error)
+        {
+            std::remove(tempPath.c_str());
+            return false;
+        }
+
+        syncDirectory(std::filesystem::path(persistPath).parent_path());
+        return true;
+    }
+
+    // Make sure the state file covers every ID below 'end'. If the file cannot
+    // be written, persistence is switched off (so later blocks don't retry the
+    // I/O) and false is returned.
+    bool persistThrough(TaskId end)
+    {
+        std::lock_guard<std::mutex> lock(persistMutex);
+        if (persistPath.empty() || end <= persistedMark.load())
+            return true;
+
+        TaskId mark = end + PERSIST_STRIDE;
+        if (!writeMark(mark))
+        {
+            persistPath.clear();
+            persistedMark.store(UINT64_MAX);
+            return false;
+        }
+        persistedMark.store(mark);
+        return true;
+    }
+
+public:
+    TaskId next()
+    {
+        ThreadBlock &block = threadBlock();
+        std::uint64_t current = generation.load(std::memory_order_acquire);
+        if (block.owner != this || block.generation != current || block.next == block.end)
+        {
+            block.owner = this;
+            block.generation = current;
+            block.next = nextBlockStart.fetch_add(BLOCK_SIZE, std::memory_order_relaxed);
+            block.end = block.next + BLOCK_SIZE;
+            if (block.end > persistedMark.load(std::memory_order_acquire) && !persistThrough(block.end))
+                std::cerr << "Warning: could not update the task ID state file; "
+                             "IDs are no longer persisted and may repeat after a restart"
+                          << std::endl;
+        }
+        return block.next++;
+    }
+
+    // Ensure every future ID is greater than 'lastUsed'
+    void resumeFrom(TaskId lastUsed)
+    {
+        TaskId wanted = lastUsed + 1;
+        TaskId current = nextBlockStart.load();
+        while (current < wanted && !nextBlockStart.compare_exchange_weak(current, wanted))
+        {
+        }
+        generation.fetch_add(1, std::memory_order_release);
+    }
+
+    // Upper bound on every ID handed out so far
+    TaskId highWaterMark() const
+    {
+        return nextBlockStart.load();
+    }
+
+    // Load the high-water mark stored at 'path' (if any), resume above it and
+    // keep the file updated from now on; returns false if the file cannot be written
+    bool enablePersistence(const std::string &path)
+    {
+        TaskId stored = 0;
+        {
+            std::ifstream in(path);
+            in >> stored;
+        }
+        if (stored > 0)
+            resumeFrom(stored - 1);
+
+        {
+            std::lock_guard<std::mutex> lock(persistMutex);
+            persistPath = path;
+            persistedMark.store(0);
+        }
+        return persistThrough(highWaterMark());
+    }
+};
+
+#endif // TASKIDALLOCATOR_H
@@ -1,8 +1,8 @@
-<<<<<<< HEAD
 #include <iostream>
 #include <vector>
 #include <deque>
 #include <string>
+#include <unordered_map>
 #include <algorithm>
 #include <iomanip>
 #include <ctime>
@@ -21,10 +21,10 @@ public:
         : title(t), description(d), priority(p), dueDate(dd), completed(false) {}
 
     // Getters
-    std::string getTitle() const { return title; }
-    std::string getDescription() const { return description; }
-    std::string getPriority() const { return priority; }
-    std::string getDueDate() const { return dueDate; }
+    const std::string &getTitle() const { return title; }
+    const std::string &getDescription() const { return description; }
+    const std::string &getPriority() const { return priority; }
+    const std::string &getDueDate() const { return dueDate; }
     bool isCompleted() const { return completed; }
 
     // Setters
@@ -38,224 +38,34 @@ public:
 class TaskManager
 {
 private:
-    std::vector<Task> normalTasks;  // For regular tasks
-    std::deque<Task> priorityTasks; // For priority tasks that need quick front/back access
-
-public:
-    // Add a new task
-    void addTask(const Task &task)
+    // Where a task lives, so title lookups do not scan both containers
+    struct TaskRef
     {
-        if (task.getPriority() == "High")
-        {
-            priorityTasks.push_front(task);
-        }
-        else if (task.getPriority() == "Low")
-        {
-            priorityTasks.push_back(task);
-        }
-        else
-        {
-            normalTasks.push_back(task);
-        }
-    }
+        bool priority;  // true if stored in priorityTasks
+        long long slot; // vector index, or logical deque index (see priorityFront)
+    };
 
-    // Display all tasks
-    void displayTasks() const
-    {
-        std::cout << "\n=== Priority Tasks ===\n";
-        displayTaskList(priorityTasks);
+    std::vector<Task> normalTasks;  // For regular tasks
+    std::deque<Task> priorityTasks; // For priority tasks that need quick front/back access
 
-        std::cout << "\n=== Normal Tasks ===\n";
-        displayTaskList(normalTasks);
-    }
+    std::unordered_map<std::string, std::vector<TaskRef>> titleIndex; // Title -> every task with that title
+    long long priorityFront = 0;                                      // Logical index of priorityTasks.front()
 
-    // Helper function to display tasks
-    template <typename Container>
-    void displayTaskList(const Container &tasks) const
+    // Rebuild the title index after tasks have been compacted
+    void rebuildTitleIndex()
     {
-        int index = 1;
-        for (const auto &task : tasks)
+        titleIndex.clear();
+        priorityFront = 0;
+        for (size_t i = 0; i < normalTasks.size(); ++i)
         {
-            std::cout << "\n"
-                      << index++ << ". Title: " << task.getTitle()
-                      << "\n   Description: " << task.getDescription()
-                      << "\n   Priority: " << task.getPriority()
-                      << "\n   Due Date: " << task.getDueDate()
-                      << "\n   Status: " << (task.isCompleted() ? "Completed" : "Pending")
-                      << "\n";
+            titleIndex[normalTasks[i].getTitle()].push_back({false, static_cast<long long>(i)});
         }
-    }
-
-    // Mark task as completed
-    bool markTaskCompleted(const std::string &title)
-    {
-        auto markComplete = [&title](std::vector<Task> &tasks) -> bool
+        for (size_t i = 0; i < priorityTasks.size(); ++i)
         {
-            for (auto &task : tasks)
-            {
-                if (task.getTitle() == title)
-                {
-                    task.setCompleted(true);
-                    return true;
-                }
-            }
-            return false;
-        };
-
-        if (markComplete(normalTasks))
-            return true;
-
-        for (auto &task : priorityTasks)
-        {
-            if (task.getTitle() == title)
-            {
-                task.setCompleted(true);
-                return true;
-            }
+            titleIndex[priorityTasks[i].getTitle()].push_back({true, static_cast<long long>(i)});
         }
-        return false;
     }
 
-    // Remove completed tasks
-    void removeCompletedTasks()
-    {
-        auto removeCompleted = [](auto &tasks)
-        {
-            tasks.erase(
-                std::remove_if(tasks.begin(), tasks.end(),
-                               [](const Task &task)
-                               { return task.isCompleted(); }),
-                tasks.end());
-        };
-
-        removeCompleted(normalTasks);
-        removeCompleted(priorityTasks);
-    }
-};
-
-int main()
-{
-    TaskManager manager;
-    int choice;
-
-    do
-    {
-        std::cout << "\n=== Task Manager Menu ===\n"
-                  << "1. Add New Task\n"
-                  << "2. Display All Tasks\n"
-                  << "3. Mark Task as Completed\n"
-                  << "4. Remove Completed Tasks\n"
-                  << "5. Exit\n"
-                  << "Enter your choice: ";
-        std::cin >> choice;
-        std::cin.ignore();
-
-        switch (choice)
-        {
-        case 1:
-        {
-            std::string title, description, priority, dueDate;
-
-            std::cout << "Enter task title: ";
-            std::getline(std::cin, title);
-
-            std::cout << "Enter task description: ";
-            std::getline(std::cin, description);
-
-            std::cout << "Enter priority (High/Medium/Low): ";
-            std::getline(std::cin, priority);
-
-            std::cout << "Enter due date (DD/MM/YYYY): ";
-            std::getline(std::cin, dueDate);
-
-            Task newTask(title, description, priority, dueDate);
-            manager.addTask(newTask);
-            std::cout << "Task added successfully!\n";
-            break;
-        }
-        case 2:
-        {
-            manager.displayTasks();
-            break;
-        }
-        case 3:
-        {
-            std::string title;
-            std::cout << "Enter task title to mark as completed: ";
-            std::getline(std::cin, title);
-
-            if (manager.markTaskCompleted(title))
-            {
-                std::cout << "Task marked as completed!\n";
-            }
-            else
-            {
-                std::cout << "Task not found!\n";
-            }
-            break;
-        }
-        case 4:
-        {
-            manager.removeCompletedTasks();
-            std::cout << "Completed tasks removed!\n";
-            break;
-        }
-        case 5:
-        {
-            std::cout << "Thank you for using Task Manager!\n";
-            break;
-        }
-        default:
-        {
-            std::cout << "Invalid choice! Please try again.\n";
-        }
-        }
-    } while (choice != 5);
-
-    return 0;
-=======
-#include <iostream>
-#include <vector>
-#include <deque>
-#include <string>
-#include <algorithm>
-#include <iomanip>
-#include <ctime>
-
-class Task
-{
-private:
-    std::string title;
-    std::string description;
-    std::string priority;
-    std::string dueDate;
-    bool completed;
-
-public:
-    Task(const std::string &t, const std::string &d, const std::string &p, const std::string &dd)
-        : title(t), description(d), priority(p), dueDate(dd), completed(false) {}
-
-    // Getters
-    std::string getTitle() const { return title; }
-    std::string getDescription() const { return description; }
-    std::string getPriority() const { return priority; }
-    std::string getDueDate() const { return dueDate; }
-    bool isCompleted() const { return completed; }
-
-    // Setters
-    void setCompleted(bool status) { completed = status; }
-    void setTitle(const std::string &t) { title = t; }
-    void setDescription(const std::string &d) { description = d; }
-    void setPriority(const std::string &p) { priority = p; }
-    void setDueDate(const std::string &dd) { dueDate = dd; }
-};
-
-class TaskManager
-{
-private:
-    std::vector<Task> normalTasks;  // For regular tasks
-    std::deque<Task> priorityTasks; // For priority tasks that need quick front/back access
-
 public:
     // Add a new task
     void addTask(const Task &task)
@@ -263,14 +73,17 @@ public:
         if (task.getPriority() == "High")
         {
             priorityTasks.push_front(task);
+            titleIndex[task.getTitle()].push_back({true, --priorityFront});
         }
         else if (task.getPriority() == "Low")
         {
             priorityTasks.push_back(task);
+            titleIndex[task.getTitle()].push_back({true, priorityFront + static_cast<long long>(priorityTasks.size() - 1)});
         }
         else
         {
             normalTasks.push_back(task);
+            titleIndex[task.getTitle()].push_back({false, static_cast<long long>(normalTasks.size() - 1)});
         }
     }
 
@@ -304,31 +117,26 @@ public:
     // Mark task as completed
     bool markTaskCompleted(const std::string &title)
     {
-        auto markComplete = [&title](std::vector<Task> &tasks) -> bool
-        {
-            for (auto &task : tasks)
-            {
-                if (task.getTitle() == title)
-                {
-                    task.setCompleted(true);
-                    return true;
-                }
-            }
+        auto it = titleIndex.find(title);
+        if (it == titleIndex.end())
             return false;
-        };
 
-        if (markComplete(normalTasks))
-            return true;
-
-        for (auto &task : priorityTasks)
+        // Prefer the first normal task, then the frontmost priority task
+        const TaskRef *best = nullptr;
+        for (const auto &ref : it->second)
         {
-            if (task.getTitle() == title)
+            if (!best || (best->priority && !ref.priority) ||
+                (best->priority == ref.priority && ref.slot < best->slot))
             {
-                task.setCompleted(true);
-                return true;
+                best = &ref;
             }
         }
-        return false;
+
+        if (best->priority)
+            priorityTasks[static_cast<size_t>(best->slot - priorityFront)].setCompleted(true);
+        else
+            normalTasks[static_cast<size_t>(best->slot)].setCompleted(true);
+        return true;
     }
 
     // Remove completed tasks
@@ -345,6 +153,7 @@ public:
 
         removeCompleted(normalTasks);
         removeCompleted(priorityTasks);
+        rebuildTitleIndex();
     }
 };
 
@@ -428,5 +237,4 @@ int main()
     } while (choice != 5);
 
     return 0;
->>>>>>> 31e08e23f34c54259e619d4f92b64e13a13828aa
 }
\ No newline at end of file
@@ -1,471 +1,899 @@
-<<<<<<< HEAD
 #ifndef TASKMANAGER_H
 #define TASKMANAGER_H
 
 #include <vector>
 #include <deque>
+#include <unordered_map>
+#include <set>
+#include <optional>
+#include <limits>
 #include <algorithm>
 #include <sstream>
 #include <chrono>
 #include "Task.h"
+#include "SlotMap.h"
+#include "TaskColumns.h"
+#include "IndexedHeap.h"
+#include "StringPool.h"
+#include "BoardMemory.h"
+
+// Order in which regular tasks are listed
+enum class TaskOrder
+{
+    Storage,  // Dense storage order
+    Priority, // Highest priority first
+    DueDate,  // Earliest due date first
+    Title     // Alphabetical
+};
+
+// Task totals for status bars, all taken from the bit-packed flag columns
+struct TaskCounts
+{
+    size_t regular = 0;
+    size_t urgent = 0;
+    size_t completed = 0;
+    size_t pending = 0;
+    size_t highPriority = 0;        // priority >= TaskColumns::HIGH_PRIORITY
+    size_t highPriorityPending = 0; // ...and not completed
+
+    std::string toJson() const
+    {
+        return "{\"regular\":" + std::to_string(regular) +
+               ",\"urgent\":" + std::to_string(urgent) +
+               ",\"completed\":" + std::to_string(completed) +
+               ",\"pending\":" + std::to_string(pending) +
+               ",\"highPriority\":" + std::to_string(highPriority) +
+               ",\"highPriorityPending\":" + std::to_string(highPriorityPending) + "}";
+    }
+};
+
+// Where a task sits in its manager: its container, its dense row there and, for
+// urgent tasks, its rank in the urgent list (lower ranks are listed first). Rows
+// move like TaskColumns rows: erasing a task moves the last row into its place.
+struct TaskPlacement
+{
+    bool urgent;
+    size_t row;
+    std::int64_t urgentRank; // 0 for regular tasks
+};
+
+// Told about every change to a TaskManager's tasks, right after it is made
+class TaskObserver
+{
+public:
+    virtual ~TaskObserver() = default;
+    virtual void taskStored(const Task &task, const TaskPlacement &placement) = 0; // Added (as the last row) or modified
+    virtual void taskRemoved(TaskId id, const TaskPlacement &placement) = 0;      // Where it was before removal
+};
 
 class TaskManager
 {
+public:
+    using TaskHandle = SlotMap<Task>::Handle;
+
 private:
-    std::vector<Task> tasks;      // Store regular tasks
-    std::deque<Task> urgentTasks; // Store urgent tasks that need quick access from both ends
+    // Where a task with a given ID currently lives
+    struct TaskLocation
+    {
+        bool urgent;                 // true if stored in urgentTasks
+        TaskHandle handle;           // Stable slot handle in tasks or urgentTasks
+        std::int64_t urgentRank = 0; // Position in urgentOrder, comparable across urgent tasks
+    };
 
-public:
-    // Add a regular task to the vector
-    void addTask(const Task &task)
+    // Urgency of a pending urgent task: higher priority first, then earlier due date
+    struct UrgencyKey
     {
-        tasks.push_back(task);
-    }
+        int priority;
+        TaskColumns::DueDay dueDate;
+        TaskId id;
+    };
 
-    // Add an urgent task (can be added to front or back of deque)
-    void addUrgentTask(const Task &task, bool addToFront = true)
+    struct MoreUrgent
     {
-        if (addToFront)
-        {
-            urgentTasks.push_front(task);
-        }
-        else
+        bool operator()(const UrgencyKey &a, const UrgencyKey &b) const
         {
-            urgentTasks.push_back(task);
+            if (a.priority != b.priority)
+                return a.priority > b.priority;
+            if (a.dueDate != b.dueDate)
+                return a.dueDate < b.dueDate;
+            return a.id < b.id;
         }
-    }
+    };
 
-    // Create task from parameters and add to regular tasks
-    void addTask(const std::string &title, const std::string &description,
-                 const std::string &dueDate, int priority, bool isUrgent = false)
-    {
-        // Parse date string (YYYY-MM-DD format)
-        std::tm tm = {};
-        std::istringstream ss(dueDate);
-        ss >> std::get_time(&tm, "%Y-%m-%d");
-        auto timePoint = std::chrono::system_clock::from_time_t(std::mktime(&tm));
+    // Every container below allocates from this board's resource stack, so it is
+    // declared first and destroyed last (the Task strings still use the heap)
+    BoardMemory memory;
 
-        Task newTask(title, description, timePoint, priority);
+    SlotMap<Task> tasks;       // Store regular tasks (O(1) erase, stable handles)
+    TaskColumns columns;       // Scalar fields of regular tasks, row-aligned with 'tasks'
+    SlotMap<Task> urgentTasks; // Store urgent tasks; their order lives in urgentOrder
+    TaskColumns urgentColumns; // Scalar fields of urgent tasks, row-aligned with 'urgentTasks'
 
-        if (isUrgent)
+    std::pmr::deque<TaskHandle> urgentOrder; // Front-to-back order of urgent tasks, quick access from both ends
+    size_t staleUrgentEntries = 0;      // Handles in urgentOrder whose task has been removed
+    std::int64_t nextFrontRank = -1;    // Rank of the next task pushed to the front of urgentOrder
+    std::int64_t nextBackRank = 0;      // ...and to the back
+
+    IndexedHeap<TaskId, UrgencyKey, MoreUrgent> urgentQueue; // Pending urgent tasks, most urgent on top
+
+    std::pmr::unordered_map<TaskId, TaskLocation> idIndex; // ID -> location, kept in sync on every mutation
+
+    // Titles are interned: each distinct title is stored once in the pool and
+    // named by a Ref, so the index and the title ordering share that one copy
+    // and two titles are equal exactly when their Refs are. Every indexed task
+    // holds one reference, so a title is freed when its last task leaves.
+    StringPool titles;
+    std::pmr::unordered_map<StringPool::Ref, std::pmr::vector<TaskId>> titleIndex; // Title -> IDs in insertion order (titles may repeat)
+
+    // Secondary orderings of the regular tasks, kept up to date on every change
+    // so that sorting only picks which one to iterate. Ties are broken by ID.
+    struct PriorityKey
+    {
+        int priority;
+        TaskId id;
+        TaskHandle handle;
+
+        bool operator<(const PriorityKey &other) const
         {
-            addUrgentTask(newTask, true);
+            return priority != other.priority ? priority > other.priority : id < other.id;
         }
-        else
+    };
+
+    struct DueDateKey
+    {
+        TaskColumns::DueDay dueDate;
+        TaskId id;
+        TaskHandle handle;
+
+        bool operator<(const DueDateKey &other) const
         {
-            addTask(newTask);
+            return dueDate != other.dueDate ? dueDate < other.dueDate : id < other.id;
         }
-    }
+    };
 
-    // Remove a task by title from regular tasks
-    bool removeTask(const std::string &title)
+    struct TitleKey
     {
-        auto it = std::find_if(tasks.begin(), tasks.end(),
-                               [&title](const Task &task)
-                               { return task.getTitle() == title; });
+        StringPool::Ref ref;    // Interned title; equal Refs mean equal titles
+        std::string_view title; // The pooled text, which never moves
+        TaskId id;
+        TaskHandle handle;
 
-        if (it != tasks.end())
+        bool operator<(const TitleKey &other) const
         {
-            tasks.erase(it);
-            return true;
+            if (ref != other.ref)
+                return title < other.title;
+            return id < other.id;
         }
-        return false;
+    };
+
+    std::pmr::set<PriorityKey> byPriority;
+    std::pmr::set<DueDateKey> byDueDate;
+    std::pmr::set<TitleKey> byTitle;
+    TaskOrder activeOrder = TaskOrder::Storage;
+
+    static constexpr size_t REBUILD_MIN_BYTES = 1 << 20; // Dead memory below this is never worth a rebuild
+
+    // Pending (not completed) tasks of both containers by (due date, ID), for range queries
+    std::pmr::set<std::pair<TaskColumns::DueDay, TaskId>> dueIndex;
+
+    TaskObserver *observer = nullptr;
+
+    TaskPlacement placementOf(const TaskLocation &location) const
+    {
+        const SlotMap<Task> &container = location.urgent ? urgentTasks : tasks;
+        return {location.urgent, container.indexOf(location.handle), location.urgentRank};
     }
 
-    // Remove a task by ID from regular tasks
-    bool removeTaskById(int id)
+    void notifyStored(const Task &task) const
     {
-        auto it = std::find_if(tasks.begin(), tasks.end(),
-                               [id](const Task &task)
-                               { return task.getId() == id; });
+        if (observer)
+            observer->taskStored(task, placementOf(idIndex.at(task.getId())));
+    }
 
-        if (it != tasks.end())
-        {
-            tasks.erase(it);
-            return true;
-        }
-        return false;
+    void notifyRemoved(TaskId id, const TaskPlacement &placement) const
+    {
+        if (observer)
+            observer->taskRemoved(id, placement);
     }
 
-    // Remove an urgent task by title
-    bool removeUrgentTask(const std::string &title)
+    void indexDueDate(const Task &task)
     {
-        auto it = std::find_if(urgentTasks.begin(), urgentTasks.end(),
-                               [&title](const Task &task)
-                               { return task.getTitle() == title; });
+        if (!task.isCompleted())
+            dueIndex.insert({task.getDueDay(), task.getId()});
+    }
 
-        if (it != urgentTasks.end())
-        {
-            urgentTasks.erase(it);
-            return true;
-        }
-        return false;
+    void unindexDueDate(const Task &task)
+    {
+        dueIndex.erase({task.getDueDay(), task.getId()});
     }
 
-    // Remove an urgent task by ID
-    bool removeUrgentTaskById(int id)
+    // Pending tasks with from <= due day < to, earliest first
+    std::vector<const Task *> pendingTasksDueIn(TaskColumns::DueDay from, TaskColumns::DueDay to) const
     {
-        auto it = std::find_if(urgentTasks.begin(), urgentTasks.end(),
-                               [id](const Task &task)
-                               { return task.getId() == id; });
+        std::vector<const Task *> matches;
+        if (to <= from)
+            return matches;
 
-        if (it != urgentTasks.end())
+        auto first = dueIndex.lower_bound({from, 0});
+        auto last = dueIndex.lower_bound({to, 0});
+        for (auto it = first; it != last; ++it)
         {
-            urgentTasks.erase(it);
-            return true;
+            matches.push_back(findTaskById(it->second));
         }
-        return false;
+        return matches;
     }
 
-    // Mark a task as completed by ID
-    bool markTaskCompleted(int id)
+    UrgencyKey urgencyKey(const Task &task) const
     {
-        // Check regular tasks
-        auto it = std::find_if(tasks.begin(), tasks.end(),
-                               [id](Task &task)
-                               { return task.getId() == id; });
+        return {task.getPriority(), task.getDueDay(), task.getId()};
+    }
 
-        if (it != tasks.end())
+    // Drop removed tasks from the ends of urgentOrder, and compact it once
+    // stale handles outnumber live ones so iteration stays proportional to size
+    void trimUrgentOrder()
+    {
+        while (!urgentOrder.empty() && !urgentTasks.contains(urgentOrder.front()))
         {
-            it->setCompleted(true);
-            return true;
+            urgentOrder.pop_front();
+            --staleUrgentEntries;
+        }
+        while (!urgentOrder.empty() && !urgentTasks.contains(urgentOrder.back()))
+        {
+            urgentOrder.pop_back();
+            --staleUrgentEntries;
         }
 
-        // Check urgent tasks
-        auto urgentIt = std::find_if(urgentTasks.begin(), urgentTasks.end(),
-                                     [id](Task &task)
-                                     { return task.getId() == id; });
+        if (staleUrgentEntries > urgentTasks.size())
+        {
+            urgentOrder.erase(std::remove_if(urgentOrder.begin(), urgentOrder.end(),
+                                             [this](TaskHandle handle)
+                                             { return !urgentTasks.contains(handle); }),
+                              urgentOrder.end());
+            staleUrgentEntries = 0;
+        }
+    }
 
-        if (urgentIt != urgentTasks.end())
+    // Visit every urgent task front to back
+    template <typename Visitor>
+    void forEachUrgentTask(Visitor visit) const
+    {
+        for (TaskHandle handle : urgentOrder)
         {
-            urgentIt->setCompleted(true);
-            return true;
+            if (const Task *task = urgentTasks.get(handle))
+                visit(*task);
         }
+    }
 
-        return false;
+    void indexTitle(const std::string &title, TaskId id)
+    {
+        titleIndex[titles.intern(title)].push_back(id);
     }
 
-    // Mark a task as completed
-    bool markTaskCompleted(const std::string &title)
+    void unindexTitle(const std::string &title, TaskId id)
     {
-        // Check regular tasks
-        auto it = std::find_if(tasks.begin(), tasks.end(),
-                               [&title](Task &task)
-                               { return task.getTitle() == title; });
+        StringPool::Ref ref;
+        if (!titles.find(title, ref))
+            return;
+
+        auto it = titleIndex.find(ref);
+        if (it == titleIndex.end())
+            return;
+
+        auto &ids = it->second;
+        auto entry = std::find(ids.begin(), ids.end(), id);
+        if (entry == ids.end())
+            return;
+
+        ids.erase(entry);
+        if (ids.empty())
+            titleIndex.erase(it);
+        titles.release(ref);
+    }
 
-        if (it != tasks.end())
-        {
-            it->setCompleted(true);
-            return true;
-        }
+    // IDs of the tasks with this title, or nullptr; the title is hashed once and
+    // never compared again, since matching tasks are then picked out by ID
+    const std::pmr::vector<TaskId> *idsWithTitle(const std::string &title) const
+    {
+        StringPool::Ref ref;
+        if (!titles.find(title, ref))
+            return nullptr;
 
-        // Check urgent tasks
-        auto urgentIt = std::find_if(urgentTasks.begin(), urgentTasks.end(),
-                                     [&title](Task &task)
-                                     { return task.getTitle() == title; });
+        auto it = titleIndex.find(ref);
+        return it != titleIndex.end() ? &it->second : nullptr;
+    }
+
+    // Oldest task with this title in the requested container
+    bool findIdByTitle(const std::string &title, bool urgent, TaskId &id) const
+    {
+        const std::pmr::vector<TaskId> *ids = idsWithTitle(title);
+        if (!ids)
+            return false;
 
-        if (urgentIt != urgentTasks.end())
+        for (TaskId candidate : *ids)
         {
-            urgentIt->setCompleted(true);
-            return true;
+            if (idIndex.at(candidate).urgent == urgent)
+            {
+                id = candidate;
+                return true;
+            }
         }
-
         return false;
     }
 
-    // Display all tasks
-    void displayAllTasks() const
+    Task *findMutableTask(TaskId id)
     {
-        std::cout << "\n=== Regular Tasks ===\n";
-        for (const auto &task : tasks)
+        return const_cast<Task *>(findTaskById(id));
+    }
+
+    // Copy a task's scalar fields back into its column row after a change
+    void refreshColumns(TaskId id)
+    {
+        auto it = idIndex.find(id);
+        if (it == idIndex.end())
+            return;
+
+        if (it->second.urgent)
         {
-            task.display();
+            size_t row = urgentTasks.indexOf(it->second.handle);
+            urgentColumns.set(row, urgentTasks[row]);
         }
-
-        std::cout << "\n=== Urgent Tasks ===\n";
-        for (const auto &task : urgentTasks)
+        else
         {
-            task.display();
+            size_t row = tasks.indexOf(it->second.handle);
+            columns.set(row, tasks[row]);
         }
     }
 
-    // Sort regular tasks by priority (high to low)
-    void sortTasksByPriority()
+    PriorityKey priorityKey(const Task &task, TaskHandle handle) const
     {
-        std::sort(tasks.begin(), tasks.end(),
-                  [](const Task &a, const Task &b)
-                  { return a.getPriority() > b.getPriority(); });
+        return {task.getPriority(), task.getId(), handle};
     }
 
-    // Sort tasks by due date (earliest first)
-    void sortTasksByDueDate()
+    DueDateKey dueDateKey(const Task &task, TaskHandle handle) const
     {
-        std::sort(tasks.begin(), tasks.end(),
-                  [](const Task &a, const Task &b)
-                  { return a.getDueDate() < b.getDueDate(); });
+        return {task.getDueDay(), task.getId(), handle};
     }
 
-    // Sort tasks by title (alphabetical)
-    void sortTasksByTitle()
+    // Requires the task's title to be interned (by indexTitle)
+    TitleKey titleKey(const Task &task, TaskHandle handle) const
     {
-        std::sort(tasks.begin(), tasks.end(),
-                  [](const Task &a, const Task &b)
-                  { return a.getTitle() < b.getTitle(); });
+        StringPool::Ref ref = 0;
+        titles.find(task.getTitle(), ref);
+        return {ref, titles.view(ref), task.getId(), handle};
     }
 
-    // Get all tasks as JSON
-    std::string getAllTasksJson() const
+    // Insert a regular task into every secondary ordering (after indexTitle)
+    void addToOrders(const Task &task, TaskHandle handle)
     {
-        std::ostringstream json;
-        json << "{\"regularTasks\":[";
+        byPriority.insert(priorityKey(task, handle));
+        byDueDate.insert(dueDateKey(task, handle));
+        byTitle.insert(titleKey(task, handle));
+    }
 
-        for (size_t i = 0; i < tasks.size(); ++i)
+    // Remove a regular task from every secondary ordering (before unindexTitle)
+    void removeFromOrders(const Task &task, TaskHandle handle)
+    {
+        byPriority.erase(priorityKey(task, handle));
+        byDueDate.erase(dueDateKey(task, handle));
+        byTitle.erase(titleKey(task, handle));
+    }
+
+    // Visit the dense row of every regular task in the active order
+    template <typename Visitor>
+    void forEachRegularRow(Visitor visit) const
+    {
+        switch (activeOrder)
         {
-            if (i > 0)
-                json << ",";
-            json << tasks[i].toJson();
+        case TaskOrder::Priority:
+            for (const auto &key : byPriority)
+                visit(tasks.indexOf(key.handle));
+            break;
+        case TaskOrder::DueDate:
+            for (const auto &key : byDueDate)
+                visit(tasks.indexOf(key.handle));
+            break;
+        case TaskOrder::Title:
+            for (const auto &key : byTitle)
+                visit(tasks.indexOf(key.handle));
+            break;
+        default:
+            for (size_t row = 0; row < tasks.size(); ++row)
+                visit(row);
+            break;
         }
+    }
 
-        json << "],\"urgentTasks\":[";
+    // Apply a change to one task, re-keying it in the orderings and columns if it is a regular task
+    template <typename Change>
+    bool updateTask(TaskId id, Change change)
+    {
+        auto it = idIndex.find(id);
+        if (it == idIndex.end())
+            return false;
 
-        for (size_t i = 0; i < urgentTasks.size(); ++i)
+        if (it->second.urgent)
         {
-            if (i > 0)
-                json << ",";
-            json << urgentTasks[i].toJson();
+            Task &task = *urgentTasks.get(it->second.handle);
+            unindexDueDate(task);
+            change(task);
+            indexDueDate(task);
+            urgentColumns.set(urgentTasks.indexOf(it->second.handle), task);
+            if (task.isCompleted())
+                urgentQueue.erase(id);
+            else if (!urgentQueue.update(id, urgencyKey(task)))
+                urgentQueue.push(id, urgencyKey(task));
+            notifyStored(task);
+            return true;
         }
 
-        json << "]}";
-        return json.str();
+        TaskHandle handle = it->second.handle;
+        Task &task = *tasks.get(handle);
+        removeFromOrders(task, handle);
+        unindexDueDate(task);
+        change(task);
+        addToOrders(task, handle);
+        indexDueDate(task);
+        columns.set(tasks.indexOf(handle), task);
+        notifyStored(task);
+        return true;
     }
 
-    // Get number of tasks
-    size_t getRegularTaskCount() const { return tasks.size(); }
-    size_t getUrgentTaskCount() const { return urgentTasks.size(); }
+    // Erase a regular task by handle and drop it from the indexes
+    void eraseTask(TaskHandle handle)
+    {
+        const Task *task = tasks.get(handle);
+        TaskId id = task->getId();
+        TaskPlacement placement = placementOf(idIndex.at(id));
+        removeFromOrders(*task, handle);
+        unindexDueDate(*task);
+        unindexTitle(task->getTitle(), id);
+        idIndex.erase(id);
+        tasks.erase(handle);
+        columns.swapRemove(placement.row);
+        notifyRemoved(id, placement);
+    }
 
-    // Get all tasks (both regular and urgent) as a single vector for sorting
-    std::vector<Task> getAllTasks() const
+    // Erase an urgent task by handle; its urgentOrder entry goes stale and is trimmed lazily
+    void eraseUrgentTask(TaskHandle handle)
     {
-        std::vector<Task> allTasks;
-        allTasks.insert(allTasks.end(), tasks.begin(), tasks.end());
-        allTasks.insert(allTasks.end(), urgentTasks.begin(), urgentTasks.end());
-        return allTasks;
+        const Task *task = urgentTasks.get(handle);
+        TaskId id = task->getId();
+        TaskPlacement placement = placementOf(idIndex.at(id));
+        unindexDueDate(*task);
+        unindexTitle(task->getTitle(), id);
+        idIndex.erase(id);
+        urgentQueue.erase(id);
+        urgentTasks.erase(handle);
+        urgentColumns.swapRemove(placement.row);
+        ++staleUrgentEntries;
+        trimUrgentOrder();
+        notifyRemoved(id, placement);
     }
-};
 
-=======
-#ifndef TASKMANAGER_H
-#define TASKMANAGER_H
+public:
+    explicit TaskManager(MemoryMode memoryMode = MemoryMode::Heap)
+        : memory(memoryMode),
+          tasks(memory.resource()),
+          columns(memory.resource()),
+          urgentTasks(memory.resource()),
+          urgentColumns(memory.resource()),
+          urgentOrder(memory.resource()),
+          urgentQueue(memory.resource()),
+          idIndex(memory.resource()),
+          titles(memory.resource()),
+          titleIndex(memory.resource()),
+          byPriority(memory.resource()),
+          byDueDate(memory.resource()),
+          byTitle(memory.resource()),
+          dueIndex(memory.resource())
+    {
+    }
 
-#include <vector>
-#include <deque>
-#include <algorithm>
-#include <sstream>
-#include <chrono>
-#include "Task.h"
+    // The containers point into 'memory', so a manager stays where it was built
+    TaskManager(const TaskManager &) = delete;
+    TaskManager &operator=(const TaskManager &) = delete;
 
-class TaskManager
-{
-private:
-    std::vector<Task> tasks;      // Store regular tasks
-    std::deque<Task> urgentTasks; // Store urgent tasks that need quick access from both ends
+    // Register the single observer (nullptr to detach); it sees changes from now on
+    void setObserver(TaskObserver *newObserver)
+    {
+        observer = newObserver;
+    }
+
+    // Report every task to the observer as if it had just been stored, row by
+    // row, e.g. to bring it up to date with a manager filled by copyInto
+    void announceTasks() const
+    {
+        for (size_t row = 0; row < tasks.size(); ++row)
+            notifyStored(tasks[row]);
+        for (size_t row = 0; row < urgentTasks.size(); ++row)
+            notifyStored(urgentTasks[row]);
+    }
 
-public:
     // Add a regular task to the vector
     void addTask(const Task &task)
     {
-        tasks.push_back(task);
+        addTask(Task(task));
+    }
+
+    // Add a regular task, moving it into storage
+    void addTask(Task &&task)
+    {
+        TaskHandle handle = tasks.insert(std::move(task));
+        const Task &stored = *tasks.get(handle);
+        columns.push_back(stored);
+        idIndex[stored.getId()] = {false, handle};
+        indexTitle(stored.getTitle(), stored.getId());
+        addToOrders(stored, handle);
+        indexDueDate(stored);
+        notifyStored(stored);
     }
 
-    // Add an urgent task (can be added to front or back of deque)
+    // Add an urgent task (can be added to front or back of the urgent list)
     void addUrgentTask(const Task &task, bool addToFront = true)
     {
+        addUrgentTask(Task(task), addToFront);
+    }
+
+    void addUrgentTask(Task &&task, bool addToFront = true)
+    {
+        TaskHandle handle = urgentTasks.insert(std::move(task));
+        const Task &stored = *urgentTasks.get(handle);
+        urgentColumns.push_back(stored);
         if (addToFront)
         {
-            urgentTasks.push_front(task);
+            urgentOrder.push_front(handle);
         }
         else
         {
-            urgentTasks.push_back(task);
+            urgentOrder.push_back(handle);
+        }
+        idIndex[stored.getId()] = {true, handle, addToFront ? nextFrontRank-- : nextBackRank++};
+        indexTitle(stored.getTitle(), stored.getId());
+        indexDueDate(stored);
+        if (!stored.isCompleted())
+            urgentQueue.push(stored.getId(), urgencyKey(stored));
+        notifyStored(stored);
+    }
+
+    // Make room for this many more regular and urgent tasks, so a bulk insert
+    // grows storage and hash tables at most once
+    void reserve(size_t regular, size_t urgent)
+    {
+        tasks.reserve(tasks.size() + regular);
+        columns.reserve(columns.size() + regular);
+        urgentTasks.reserve(urgentTasks.size() + urgent);
+        urgentColumns.reserve(urgentColumns.size() + urgent);
+        urgentQueue.reserve(urgentQueue.size() + urgent);
+        idIndex.reserve(idIndex.size() + regular + urgent);
+        titleIndex.reserve(titleIndex.size() + regular + urgent);
+        titles.reserve(titles.internedCount() + regular + urgent);
+    }
+
+    // Add many regular tasks, moving each into place after a single reserve
+    void addTasks(std::vector<Task> &&batch)
+    {
+        reserve(batch.size(), 0);
+        for (Task &task : batch)
+        {
+            addTask(std::move(task));
+        }
+        batch.clear();
+    }
+
+    // Add many urgent tasks, in order, as if by addUrgentTask one at a time
+    void addUrgentTasks(std::vector<Task> &&batch, bool addToFront = true)
+    {
+        reserve(0, batch.size());
+        for (Task &task : batch)
+        {
+            addUrgentTask(std::move(task), addToFront);
+        }
+        batch.clear();
+    }
+
+    // Replace existing tasks with new versions carrying the same IDs (e.g. edited
+    // copies), moving them in; returns how many IDs were found
+    size_t updateTasks(std::vector<Task> &&batch)
+    {
+        size_t updated = 0;
+        for (Task &replacement : batch)
+        {
+            TaskId id = replacement.getId();
+            bool found = updateTask(id, [this, id, &replacement](Task &task)
+                                    {
+                                        if (task.getTitle() != replacement.getTitle())
+                                        {
+                                            unindexTitle(task.getTitle(), id);
+                                            indexTitle(replacement.getTitle(), id);
+                                        }
+                                        task = std::move(replacement); });
+            if (found)
+                ++updated;
+        }
+        batch.clear();
+        return updated;
+    }
+
+    // Look up a task by ID in O(1); returns nullptr if it does not exist
+    const Task *findTaskById(TaskId id) const
+    {
+        auto it = idIndex.find(id);
+        if (it == idIndex.end())
+            return nullptr;
+
+        if (it->second.urgent)
+            return urgentTasks.get(it->second.handle);
+        return tasks.get(it->second.handle);
+    }
+
+    // Stable handle of a regular task; handles stay valid across other erases and sorts
+    bool findTaskHandle(TaskId id, TaskHandle &handle) const
+    {
+        auto it = idIndex.find(id);
+        if (it == idIndex.end() || it->second.urgent)
+            return false;
+
+        handle = it->second.handle;
+        return true;
+    }
+
+    // Resolve a handle obtained from findTaskHandle; nullptr once the task is removed
+    const Task *getTask(TaskHandle handle) const
+    {
+        return tasks.get(handle);
+    }
+
+    // All tasks sharing a title, oldest first; costs O(1) plus the number of matches
+    std::vector<const Task *> findTasksByTitle(const std::string &title) const
+    {
+        std::vector<const Task *> matches;
+        if (const std::pmr::vector<TaskId> *ids = idsWithTitle(title))
+        {
+            matches.reserve(ids->size());
+            for (TaskId id : *ids)
+            {
+                matches.push_back(findTaskById(id));
+            }
         }
+        return matches;
+    }
+
+    // Change a task's title and move it to the new title bucket
+    bool renameTask(TaskId id, const std::string &title)
+    {
+        return updateTask(id, [this, id, &title](Task &task)
+                          {
+                              unindexTitle(task.getTitle(), id);
+                              task.setTitle(title);
+                              indexTitle(title, id); });
+    }
+
+    // Change a task's priority, keeping the priority ordering and the urgent queue current
+    bool setTaskPriority(TaskId id, int priority)
+    {
+        return updateTask(id, [priority](Task &task)
+                          { task.setPriority(priority); });
+    }
+
+    // Change a task's due date, keeping the due date ordering current
+    bool setTaskDueDate(TaskId id, const std::chrono::system_clock::time_point &dueDate)
+    {
+        return updateTask(id, [&dueDate](Task &task)
+                          { task.setDueDate(dueDate); });
+    }
+
+    // Parse a "YYYY-MM-DD" date string; anything unparseable falls back to today
+    static std::int32_t dueDayOrToday(const std::string &dueDate)
+    {
+        std::int32_t dueDay;
+        if (!parseIsoDate(dueDate.data(), dueDate.size(), dueDay))
+            dueDay = daysFromTimePoint(std::chrono::system_clock::now());
+        return dueDay;
     }
 
     // Create task from parameters and add to regular tasks
     void addTask(const std::string &title, const std::string &description,
                  const std::string &dueDate, int priority, bool isUrgent = false)
     {
-        // Parse date string (YYYY-MM-DD format)
-        std::tm tm = {};
-        std::istringstream ss(dueDate);
-        ss >> std::get_time(&tm, "%Y-%m-%d");
-        auto timePoint = std::chrono::system_clock::from_time_t(std::mktime(&tm));
-
-        Task newTask(title, description, timePoint, priority);
+        Task newTask(title, description, dueDayOrToday(dueDate), priority);
 
         if (isUrgent)
         {
-            addUrgentTask(newTask, true);
+            addUrgentTask(std::move(newTask), true);
         }
         else
         {
-            addTask(newTask);
+            addTask(std::move(newTask));
         }
     }
 
     // Remove a task by title from regular tasks
     bool removeTask(const std::string &title)
     {
-        auto it = std::find_if(tasks.begin(), tasks.end(),
-                               [&title](const Task &task)
-                               { return task.getTitle() == title; });
+        TaskId id;
+        if (!findIdByTitle(title, false, id))
+            return false;
 
-        if (it != tasks.end())
-        {
-            tasks.erase(it);
-            return true;
-        }
-        return false;
+        return removeTaskById(id);
     }
 
     // Remove a task by ID from regular tasks
-    bool removeTaskById(int id)
+    bool removeTaskById(TaskId id)
     {
-        auto it = std::find_if(tasks.begin(), tasks.end(),
-                               [id](const Task &task)
-                               { return task.getId() == id; });
+        auto it = idIndex.find(id);
+        if (it == idIndex.end() || it->second.urgent)
+            return false;
 
-        if (it != tasks.end())
-        {
-            tasks.erase(it);
-            return true;
-        }
-        return false;
+        eraseTask(it->second.handle);
+        return true;
     }
 
     // Remove an urgent task by title
     bool removeUrgentTask(const std::string &title)
     {
-        auto it = std::find_if(urgentTasks.begin(), urgentTasks.end(),
-                               [&title](const Task &task)
-                               { return task.getTitle() == title; });
+        TaskId id;
+        if (!findIdByTitle(title, true, id))
+            return false;
 
-        if (it != urgentTasks.end())
-        {
-            urgentTasks.erase(it);
-            return true;
-        }
-        return false;
+        return removeUrgentTaskById(id);
     }
 
     // Remove an urgent task by ID
-    bool removeUrgentTaskById(int id)
+    bool removeUrgentTaskById(TaskId id)
     {
-        auto it = std::find_if(urgentTasks.begin(), urgentTasks.end(),
-                               [id](const Task &task)
-                               { return task.getId() == id; });
+        auto it = idIndex.find(id);
+        if (it == idIndex.end() || !it->second.urgent)
+            return false;
 
-        if (it != urgentTasks.end())
-        {
-            urgentTasks.erase(it);
-            return true;
-        }
-        return false;
+        eraseUrgentTask(it->second.handle);
+        return true;
     }
 
-    // Mark a task as completed by ID
-    bool markTaskCompleted(int id)
+    // Remove a task by ID from whichever container holds it
+    bool removeAnyTaskById(TaskId id)
+    {
+        auto it = idIndex.find(id);
+        if (it == idIndex.end())
+            return false;
+
+        if (it->second.urgent)
+            eraseUrgentTask(it->second.handle);
+        else
+            eraseTask(it->second.handle);
+        return true;
+    }
+
+    // Remove every completed task from both containers; returns how many were removed
+    size_t removeCompletedTasks()
     {
-        // Check regular tasks
-        auto it = std::find_if(tasks.begin(), tasks.end(),
-                               [id](Task &task)
-                               { return task.getId() == id; });
+        size_t removed = 0;
 
-        if (it != tasks.end())
+        // Walk the completion bits backwards, skipping whole words of pending rows.
+        // The row swapped into a hole comes from above it, so it has already been checked.
+        for (size_t i = columns.completed.findLastSet(tasks.size()); i != BitColumn::npos;
+             i = columns.completed.findLastSet(i))
         {
-            it->setCompleted(true);
-            return true;
+            eraseTask(tasks.handleAt(i));
+            ++removed;
         }
 
-        // Check urgent tasks
-        auto urgentIt = std::find_if(urgentTasks.begin(), urgentTasks.end(),
-                                     [id](Task &task)
-                                     { return task.getId() == id; });
-
-        if (urgentIt != urgentTasks.end())
+        for (size_t i = urgentColumns.completed.findLastSet(urgentTasks.size()); i != BitColumn::npos;
+             i = urgentColumns.completed.findLastSet(i))
         {
-            urgentIt->setCompleted(true);
-            return true;
+            eraseUrgentTask(urgentTasks.handleAt(i));
+            ++removed;
         }
 
-        return false;
+        return removed;
+    }
+
+    // Mark a task as completed by ID
+    bool markTaskCompleted(TaskId id)
+    {
+        Task *task = findMutableTask(id);
+        if (!task)
+            return false;
+
+        unindexDueDate(*task);
+        task->setCompleted(true);
+        refreshColumns(id);
+        urgentQueue.erase(id); // Completed work is no longer dispatched
+        notifyStored(*task);
+        return true;
     }
 
     // Mark a task as completed
     bool markTaskCompleted(const std::string &title)
     {
-        // Check regular tasks
-        auto it = std::find_if(tasks.begin(), tasks.end(),
-                               [&title](Task &task)
-                               { return task.getTitle() == title; });
-
-        if (it != tasks.end())
-        {
-            it->setCompleted(true);
-            return true;
-        }
-
-        // Check urgent tasks
-        auto urgentIt = std::find_if(urgentTasks.begin(), urgentTasks.end(),
-                                     [&title](Task &task)
-                                     { return task.getTitle() == title; });
-
-        if (urgentIt != urgentTasks.end())
-        {
-            urgentIt->setCompleted(true);
-            return true;
-        }
-
-        return false;
+        // Regular tasks take precedence over urgent ones with the same title
+        const std::pmr::vector<TaskId> *ids = idsWithTitle(title);
+        if (!ids)
+            return false;
+
+        auto regular = std::find_if(ids->begin(), ids->end(), [this](TaskId id)
+                                    { return !idIndex.at(id).urgent; });
+        return markTaskCompleted(regular != ids->end() ? *regular : ids->front());
     }
 
     // Display all tasks
     void displayAllTasks() const
     {
         std::cout << "\n=== Regular Tasks ===\n";
-        for (const auto &task : tasks)
-        {
-            task.display();
-        }
+        forEachRegularRow([this](size_t row)
+                          { tasks[row].display(); });
 
         std::cout << "\n=== Urgent Tasks ===\n";
-        for (const auto &task : urgentTasks)
-        {
-            task.display();
-        }
+        forEachUrgentTask([](const Task &task)
+                          { task.display(); });
     }
 
-    // Sort regular tasks by priority (high to low)
+    // List regular tasks by priority (high to low); the ordering is already maintained
     void sortTasksByPriority()
     {
-        std::sort(tasks.begin(), tasks.end(),
-                  [](const Task &a, const Task &b)
-                  { return a.getPriority() > b.getPriority(); });
+        activeOrder = TaskOrder::Priority;
     }
 
-    // Sort tasks by due date (earliest first)
+    // List tasks by due date (earliest first)
     void sortTasksByDueDate()
     {
-        std::sort(tasks.begin(), tasks.end(),
-                  [](const Task &a, const Task &b)
-                  { return a.getDueDate() < b.getDueDate(); });
+        activeOrder = TaskOrder::DueDate;
     }
 
-    // Sort tasks by title (alphabetical)
+    // List tasks by title (alphabetical)
     void sortTasksByTitle()
     {
-        std::sort(tasks.begin(), tasks.end(),
-                  [](const Task &a, const Task &b)
-                  { return a.getTitle() < b.getTitle(); });
+        activeOrder = TaskOrder::Title;
+    }
+
+    TaskOrder getActiveOrder() const { return activeOrder; }
+
+    // True if regular task 'a' is listed before 'b' under 'order', as the
+    // maintained orderings compare them (Storage order goes by row instead)
+    static bool listedBefore(TaskOrder order, const Task &a, const Task &b)
+    {
+        switch (order)
+        {
+        case TaskOrder::Priority:
+            if (a.getPriority() != b.getPriority())
+                return a.getPriority() > b.getPriority();
+            break;
+        case TaskOrder::DueDate:
+            if (a.getDueDay() != b.getDueDay())
+                return a.getDueDay() < b.getDueDay();
+            break;
+        case TaskOrder::Title:
+            if (a.getTitle() != b.getTitle())
+                return a.getTitle() < b.getTitle();
+            break;
+        default:
+            break;
+        }
+        return a.getId() < b.getId();
+    }
+
+    // Allocation counters for this manager's containers and their backing blocks
+    BoardMemoryStats getMemoryStats() const { return memory.getStats(); }
+
+    // Monotonic memory is never reused, so churn leaves dead blocks behind. True
+    // once they outweigh the live data enough that copying the board into a
+    // fresh manager (copyInto) is worth it; always false in the other modes.
+    bool shouldRebuild() const
+    {
+        BoardMemoryStats stats = memory.getStats();
+        return stats.mode == MemoryMode::Monotonic &&
+               stats.reserved.bytesInUse > 4 * stats.requested.bytesInUse + REBUILD_MIN_BYTES;
+    }
+
+    // Copy every task into an empty manager, keeping IDs, storage order, the
+    // urgent list order and the active ordering
+    void copyInto(TaskManager &target) const
+    {
+        target.reserve(tasks.size(), urgentTasks.size());
+        for (const Task &task : tasks)
+            target.addTask(task);
+        forEachUrgentTask([&target](const Task &task)
+                          { target.addUrgentTask(task, false); });
+        target.activeOrder = activeOrder;
     }
 
     // Get all tasks as JSON
@@ -474,39 +902,137 @@ public:
         std::ostringstream json;
         json << "{\"regularTasks\":[";
 
-        for (size_t i = 0; i < tasks.size(); ++i)
-        {
-            if (i > 0)
-                json << ",";
-            json << tasks[i].toJson();
-        }
+        bool first = true;
+        forEachRegularRow([this, &json, &first](size_t row)
+                          {
+                              if (!first)
+                                  json << ",";
+                              first = false;
+                              json << tasks[row].toJson(); });
 
         json << "],\"urgentTasks\":[";
 
-        for (size_t i = 0; i < urgentTasks.size(); ++i)
-        {
-            if (i > 0)
-                json << ",";
-            json << urgentTasks[i].toJson();
-        }
+        first = true;
+        forEachUrgentTask([&json, &first](const Task &task)
+                          {
+                              if (!first)
+                                  json << ",";
+                              first = false;
+                              json << task.toJson(); });
 
         json << "]}";
         return json.str();
     }
 
+    // Most urgent pending urgent task (highest priority, then earliest due), or nullptr
+    const Task *peekNextUrgentTask() const
+    {
+        if (urgentQueue.empty())
+            return nullptr;
+        return findTaskById(urgentQueue.top().id);
+    }
+
+    // Remove the most urgent pending urgent task and hand it to the caller
+    std::optional<Task> popNextUrgentTask()
+    {
+        const Task *task = peekNextUrgentTask();
+        if (!task)
+            return std::nullopt;
+
+        Task next = *task;
+        removeUrgentTaskById(next.getId());
+        return next;
+    }
+
+    // Pending tasks whose due date (start of the due day, UTC) is before 'now', earliest first; O(log n + k)
+    std::vector<const Task *> getOverdueTasks(std::chrono::system_clock::time_point now) const
+    {
+        return pendingTasksDueIn(std::numeric_limits<TaskColumns::DueDay>::min(), daysCeilFromTimePoint(now));
+    }
+
+    // Pending tasks due in [from, from + window), earliest first; O(log n + k)
+    std::vector<const Task *> getTasksDueWithin(std::chrono::system_clock::time_point from,
+                                                std::chrono::system_clock::duration window) const
+    {
+        return pendingTasksDueIn(daysCeilFromTimePoint(from), daysCeilFromTimePoint(from + window));
+    }
+
     // Get number of tasks
     size_t getRegularTaskCount() const { return tasks.size(); }
     size_t getUrgentTaskCount() const { return urgentTasks.size(); }
+    size_t getPendingUrgentTaskCount() const { return urgentQueue.size(); }
+
+    // Count completed tasks with a popcount over the completion bits
+    size_t getCompletedTaskCount() const
+    {
+        return columns.completed.count() + urgentColumns.completed.count();
+    }
+
+    size_t getPendingTaskCount() const
+    {
+        return tasks.size() + urgentTasks.size() - getCompletedTaskCount();
+    }
+
+    // Every status bar total in one pass over the flag bits; no task record is read
+    TaskCounts getTaskCounts() const
+    {
+        TaskCounts counts;
+        counts.regular = tasks.size();
+        counts.urgent = urgentTasks.size();
+        counts.completed = getCompletedTaskCount();
+        counts.pending = counts.regular + counts.urgent - counts.completed;
+        counts.highPriority = columns.highPriority.count() + urgentColumns.highPriority.count();
+        counts.highPriorityPending = columns.highPriority.countAndNot(columns.completed) +
+                                     urgentColumns.highPriority.countAndNot(urgentColumns.completed);
+        return counts;
+    }
+
+    // Call 'visit' for every task in listing order (regular tasks in the active
+    // order, then urgent tasks) without copying any of them
+    template <typename Visitor>
+    void forEachTask(Visitor visit) const
+    {
+        forEachRegularRow([this, &visit](size_t row)
+                          { visit(tasks[row]); });
+        forEachUrgentTask([&visit](const Task &task)
+                          { visit(task); });
+    }
 
     // Get all tasks (both regular and urgent) as a single vector for sorting
     std::vector<Task> getAllTasks() const
     {
         std::vector<Task> allTasks;
-        allTasks.insert(allTasks.end(), tasks.begin(), tasks.end());
-        allTasks.insert(allTasks.end(), urgentTasks.begin(), urgentTasks.end());
+        allTasks.reserve(tasks.size() + urgentTasks.size());
+        forEachTask([&allTasks](const Task &task)
+                    { allTasks.push_back(task); });
         return allTasks;
     }
+
+    // Like getAllTasks, without the completed tasks ("hide completed" views).
+    // Pending rows are found from the completion bits; only they are copied.
+    std::vector<Task> getPendingTasks() const
+    {
+        std::vector<Task> pending;
+        pending.reserve(getPendingTaskCount());
+        if (activeOrder == TaskOrder::Storage)
+        {
+            columns.completed.forEachClear([this, &pending](size_t row)
+                                           { pending.push_back(tasks[row]); });
+        }
+        else
+        {
+            forEachRegularRow([this, &pending](size_t row)
+                              {
+                                  if (!columns.completed.test(row))
+                                      pending.push_back(tasks[row]); });
+        }
+        for (TaskHandle handle : urgentOrder)
+        {
+            if (urgentTasks.contains(handle) && !urgentColumns.completed.test(urgentTasks.indexOf(handle)))
+                pending.push_back(*urgentTasks.get(handle));
+        }
+        return pending;
+    }
 };
 
->>>>>>> 31e08e23f34c54259e619d4f92b64e13a13828aa
 #endif // TASKMANAGER_H
\ No newline at end of file
@@ -0,0 +1,168 @@
+#ifndef TASKSNAPSHOT_H
+#define TASKSNAPSHOT_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+#include "TaskManager.h"
+
+// One task in a snapshot: a shared immutable copy (the same one the lock-free
+// ID map serves) and, for urgent tasks, its rank in the urgent list
+struct SnapshotEntry
+{
+    std::shared_ptr<const Task> task;
+    std::int64_t urgentRank = 0;
+};
+
+// Up to SnapshotRows::CHUNK_SIZE consecutive rows of one container
+using SnapshotChunk = std::vector<SnapshotEntry>;
+using SharedChunks = std::vector<std::shared_ptr<const SnapshotChunk>>;
+
+// Immutable view of a board as of some write. Readers that hold one keep it
+// alive through the shared_ptr; it is freed when the last one lets go.
+//
+// It holds the rows of both containers as chunks shared with the snapshots
+// before and after it, plus the listing order, so publishing one costs the
+// writer the chunk pointer arrays rather than a copy of every task. The sorted
+// listing is worked out by the first reader that asks for it.
+class TaskSnapshot
+{
+private:
+    SharedChunks regularChunks;
+    SharedChunks urgentChunks;
+    mutable std::once_flag listed;
+    mutable std::vector<const Task *> listing;
+
+    void buildListing() const
+    {
+        for (const auto &chunk : regularChunks)
+            for (const SnapshotEntry &entry : *chunk)
+                listing.push_back(entry.task.get());
+        if (order != TaskOrder::Storage)
+        {
+            TaskOrder by = order;
+            std::sort(listing.begin(), listing.end(), [by](const Task *a, const Task *b)
+                      { return TaskManager::listedBefore(by, *a, *b); });
+        }
+
+        std::vector<std::pair<std::int64_t, const Task *>> urgent;
+        urgent.reserve(urgentCount);
+        for (const auto &chunk : urgentChunks)
+            for (const SnapshotEntry &entry : *chunk)
+                urgent.emplace_back(entry.urgentRank, entry.task.get());
+        std::sort(urgent.begin(), urgent.end());
+        for (const auto &entry : urgent)
+            listing.push_back(entry.second);
+    }
+
+public:
+    std::uint64_t version = 0; // Number of writes it reflects
+    TaskOrder order = TaskOrder::Storage;
+    size_t regularCount = 0;
+    size_t urgentCount = 0;
+
+    TaskSnapshot() = default;
+
+    TaskSnapshot(std::uint64_t version, TaskOrder order, SharedChunks regular, size_t regularCount,
+                 SharedChunks urgent, size_t urgentCount)
+        : regularChunks(std::move(regular)), urgentChunks(std::move(urgent)),
+          version(version), order(order), regularCount(regularCount), urgentCount(urgentCount)
+    {
+    }
+
+    // Every task in listing order (regular tasks in the active order, then urgent
+    // tasks), as TaskManager::forEachTask visits them
+    const std::vector<const Task *> &tasks() const
+    {
+        std::call_once(listed, [this]
+                       {
+                           listing.reserve(regularCount + urgentCount);
+                           buildListing(); });
+        return listing;
+    }
+};
+
+// Writer-side copy of one container's dense rows, kept in step with the manager
+// and split into chunks that published snapshots share. A chunk is copied
+// before a change only while a snapshot still holds it, so a write costs a copy
+// of the chunks it touches, not of the board.
+class SnapshotRows
+{
+public:
+    static constexpr size_t CHUNK_SIZE = 256;
+
+private:
+    std::vector<std::shared_ptr<SnapshotChunk>> chunks;
+    size_t count = 0;
+
+    SnapshotChunk &writableChunk(size_t row)
+    {
+        std::shared_ptr<SnapshotChunk> &chunk = chunks[row / CHUNK_SIZE];
+        if (chunk.use_count() > 1)
+        {
+            auto copy = std::make_shared<SnapshotChunk>();
+            copy->reserve(CHUNK_SIZE);
+            copy->assign(chunk->begin(), chunk->end());
+            chunk = std::move(copy);
+        }
+        else
+        {
+            // Sole owner: order this after the last reader's release of the chunk
+            std::atomic_thread_fence(std::memory_order_acquire);
+        }
+        return *chunk;
+    }
+
+public:
+    size_t size() const { return count; }
+
+    // Set 'row' to 'entry'; row size() appends
+    void store(size_t row, SnapshotEntry entry)
+    {
+        if (row < count)
+        {
+            writableChunk(row)[row % CHUNK_SIZE] = std::move(entry);
+            return;
+        }
+
+        if (count % CHUNK_SIZE == 0)
+        {
+            chunks.push_back(std::make_shared<SnapshotChunk>());
+            chunks.back()->reserve(CHUNK_SIZE);
+        }
+        writableChunk(count).push_back(std::move(entry));
+        ++count;
+    }
+
+    // Drop 'row', moving the last row into its place
+    void swapRemove(size_t row)
+    {
+        size_t last = count - 1;
+        if (row != last)
+        {
+            SnapshotEntry moved = (*chunks[last / CHUNK_SIZE])[last % CHUNK_SIZE];
+            writableChunk(row)[row % CHUNK_SIZE] = std::move(moved);
+        }
+        writableChunk(last).pop_back();
+        if (chunks.back()->empty())
+            chunks.pop_back();
+        --count;
+    }
+
+    void clear()
+    {
+        chunks.clear();
+        count = 0;
+    }
+
+    SharedChunks share() const
+    {
+        return SharedChunks(chunks.begin(), chunks.end());
+    }
+};
+
+#endif // TASKSNAPSHOT_H
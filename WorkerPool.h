@@ -0,0 +1,189 @@
+#ifndef WORKERPOOL_H
+#define WORKERPOOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads for request handling, started once. Every worker
+// has its own deque: submissions are spread round-robin over the deques, a
+// worker takes the oldest job from its own, and a worker whose deque is empty
+// steals the newest job from another before going to sleep. Each deque holds at
+// most 'queueLimit' jobs; when every deque is full trySubmit() refuses the job
+// so the caller can shed load (the web server answers 503) instead of queueing
+// without bound.
+class WorkerPool
+{
+public:
+    using Job = std::function<void()>;
+
+    struct Stats
+    {
+        std::uint64_t submitted = 0;
+        std::uint64_t rejected = 0; // Refused because every queue was full
+        std::uint64_t stolen = 0;   // Run by a worker other than the one it was queued on
+        std::uint64_t completed = 0;
+
+        std::string toJson() const
+        {
+            return "{\"submitted\":" + std::to_string(submitted) +
+                   ",\"rejected\":" + std::to_string(rejected) +
+                   ",\"stolen\":" + std::to_string(stolen) +
+                   ",\"completed\":" + std::to_string(completed) + "}";
+        }
+    };
+
+private:
+    // Padded to a cache line so neighbouring queue locks do not false-share
+    struct alignas(64) WorkQueue
+    {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+    };
+
+    size_t queueLimit;
+    std::vector<std::unique_ptr<WorkQueue>> queues;
+    std::atomic<size_t> nextQueue{0};
+    std::atomic<size_t> queuedJobs{0}; // Across all queues; sleeping workers wait for it to be non-zero
+    std::atomic<bool> running{true};
+    std::mutex wakeMutex;
+    std::condition_variable wake;
+    std::atomic<std::uint64_t> submittedCount{0};
+    std::atomic<std::uint64_t> rejectedCount{0};
+    std::atomic<std::uint64_t> stolenCount{0};
+    std::atomic<std::uint64_t> completedCount{0};
+    std::vector<std::thread> workers; // Last, so everything above exists before they start
+
+    bool popOwn(size_t self, Job &job)
+    {
+        WorkQueue &queue = *queues[self];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.jobs.empty())
+            return false;
+        job = std::move(queue.jobs.front());
+        queue.jobs.pop_front();
+        return true;
+    }
+
+    bool steal(size_t self, Job &job)
+    {
+        for (size_t i = 1; i < queues.size(); ++i)
+        {
+            WorkQueue &victim = *queues[(self + i) % queues.size()];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.jobs.empty())
+            {
+                job = std::move(victim.jobs.back());
+                victim.jobs.pop_back();
+                stolenCount.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void run(size_t self)
+    {
+        for (;;)
+        {
+            Job job;
+            if (popOwn(self, job) || steal(self, job))
+            {
+                queuedJobs.fetch_sub(1);
+                try
+                {
+                    job();
+                }
+                catch (const std::exception &e)
+                {
+                    std::cerr << "Worker job failed: " << e.what() << std::endl;
+                }
+                completedCount.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(wakeMutex);
+            wake.wait(lock, [this]
+                      { return queuedJobs.load() > 0 || !running.load(); });
+            if (!running.load() && queuedJobs.load() == 0)
+                return;
+        }
+    }
+
+public:
+    static size_t defaultWorkerCount()
+    {
+        return std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    WorkerPool(size_t workerCount, size_t queueLimit) : queueLimit(std::max<size_t>(1, queueLimit))
+    {
+        workerCount = std::max<size_t>(1, workerCount);
+        for (size_t i = 0; i < workerCount; ++i)
+            queues.push_back(std::make_unique<WorkQueue>());
+        for (size_t i = 0; i < workerCount; ++i)
+            workers.emplace_back(&WorkerPool::run, this, i);
+    }
+
+    WorkerPool(const WorkerPool &) = delete;
+    WorkerPool &operator=(const WorkerPool &) = delete;
+
+    // Jobs already queued still run before the workers exit
+    ~WorkerPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(wakeMutex);
+            running.store(false);
+        }
+        wake.notify_all();
+        for (auto &worker : workers)
+            worker.join();
+    }
+
+    // Queue a job; false (and the job is not run) when every queue is at its limit
+    bool trySubmit(Job job)
+    {
+        size_t start = nextQueue.fetch_add(1, std::memory_order_relaxed);
+        for (size_t i = 0; i < queues.size(); ++i)
+        {
+            WorkQueue &queue = *queues[(start + i) % queues.size()];
+            std::unique_lock<std::mutex> lock(queue.mutex);
+            if (queue.jobs.size() < queueLimit)
+            {
+                queue.jobs.push_back(std::move(job));
+                queuedJobs.fetch_add(1);
+                lock.unlock();
+
+                submittedCount.fetch_add(1, std::memory_order_relaxed);
+                {
+                    // Taking the lock orders this wake-up after a sleeper's predicate check
+                    std::lock_guard<std::mutex> wakeLock(wakeMutex);
+                }
+                wake.notify_one();
+                return true;
+            }
+        }
+        rejectedCount.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    size_t getWorkerCount() const { return workers.size(); }
+    size_t getQueueLimit() const { return queueLimit; }
+
+    Stats getStats() const
+    {
+        return {submittedCount.load(), rejectedCount.load(), stolenCount.load(), completedCount.load()};
+    }
+};
+
+#endif // WORKERPOOL_H
@@ -0,0 +1,262 @@
+// Allocation and memory benchmark for a large board.
+//
+// Replaces the global operator new to count heap allocations and live heap
+// bytes, builds a board of N tasks (default 100000) and runs the hot read paths
+// twice: once copying each string field the way the old by-value getters did,
+// and once through the reference getters / field visitor.
+//
+// With --memory it instead reports resident bytes per task for each storage
+// layout and board memory mode. Usage: ./task_bench [--memory] [N]
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+#include "TaskManager.h"
+#include "TaskHtml.h"
+#include "CompactTask.h"
+
+static std::atomic<unsigned long long> allocationCount{0};
+static std::atomic<unsigned long long> allocatedBytes{0};
+static std::atomic<long long> liveBytes{0};
+
+// Each block is prefixed with its size so delete can keep liveBytes exact. The
+// replacements stay out of line so GCC does not pair the inlined malloc/free
+// with new/delete and warn about a mismatch.
+static constexpr std::size_t HEADER = alignof(std::max_align_t);
+
+[[gnu::noinline]] void *operator new(std::size_t size)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    liveBytes.fetch_add(static_cast<long long>(size), std::memory_order_relaxed);
+    if (char *block = static_cast<char *>(std::malloc(size + HEADER)))
+    {
+        *reinterpret_cast<std::size_t *>(block) = size;
+        return block + HEADER;
+    }
+    throw std::bad_alloc();
+}
+
+[[gnu::noinline]] void operator delete(void *p) noexcept
+{
+    if (!p)
+        return;
+    char *block = static_cast<char *>(p) - HEADER;
+    liveBytes.fetch_sub(static_cast<long long>(*reinterpret_cast<std::size_t *>(block)), std::memory_order_relaxed);
+    std::free(block);
+}
+
+void operator delete(void *p, std::size_t) noexcept { operator delete(p); }
+
+// Over-aligned blocks, which std::pmr::new_delete_resource asks for, get a header
+// as large as their alignment
+void *operator new(std::size_t size, std::align_val_t alignment)
+{
+    std::size_t header = std::max(HEADER, static_cast<std::size_t>(alignment));
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    liveBytes.fetch_add(static_cast<long long>(size), std::memory_order_relaxed);
+    std::size_t total = (size + header + header - 1) / header * header;
+    if (char *block = static_cast<char *>(std::aligned_alloc(header, total)))
+    {
+        *reinterpret_cast<std::size_t *>(block) = size;
+        return block + header;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p, std::align_val_t alignment) noexcept
+{
+    if (!p)
+        return;
+    char *block = static_cast<char *>(p) - std::max(HEADER, static_cast<std::size_t>(alignment));
+    liveBytes.fetch_sub(static_cast<long long>(*reinterpret_cast<std::size_t *>(block)), std::memory_order_relaxed);
+    std::free(block);
+}
+
+void operator delete(void *p, std::size_t, std::align_val_t alignment) noexcept { operator delete(p, alignment); }
+
+// Stand-in for the old getters, which returned a fresh std::string
+static std::string copyOf(const std::string &field) { return field; }
+
+template <typename Work>
+static void measure(const char *name, Work work)
+{
+    unsigned long long allocations = allocationCount.load();
+    unsigned long long bytes = allocatedBytes.load();
+    auto start = std::chrono::steady_clock::now();
+
+    size_t result = work();
+
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+    std::printf("%-34s %10llu allocs %12llu bytes %8lld us  (result %zu)\n", name,
+                allocationCount.load() - allocations, allocatedBytes.load() - bytes,
+                static_cast<long long>(elapsed.count()), result);
+}
+
+// Titles and descriptions are longer than the small-string buffer, as real ones are
+static Task makeTask(size_t i)
+{
+    return Task("Quarterly planning item #" + std::to_string(i % 5000),
+                "Follow up with the owning team and record the outcome",
+                static_cast<std::int32_t>(20000 + i % 365), static_cast<int>(i % 6));
+}
+
+// Heap bytes per task that 'build' leaves resident
+template <typename Build>
+static void reportResident(const char *name, size_t count, Build build)
+{
+    long long before = liveBytes.load();
+    auto owner = build();
+    long long after = liveBytes.load();
+    std::printf("%-34s %12lld bytes %10.1f bytes/task\n", name, after - before,
+                static_cast<double>(after - before) / static_cast<double>(count));
+}
+
+static int memoryReport(size_t count)
+{
+    std::printf("Resident memory for %zu tasks (sizeof(Task) = %zu, sizeof(CompactTask) = %zu)\n\n",
+                count, sizeof(Task), sizeof(CompactTask));
+
+    reportResident("std::vector<Task>", count, [count]
+                   {
+        auto tasks = std::make_unique<std::vector<Task>>();
+        tasks->reserve(count);
+        for (size_t i = 0; i < count; ++i)
+            tasks->push_back(makeTask(i));
+        return tasks; });
+
+    for (MemoryMode mode : {MemoryMode::Heap, MemoryMode::Pool, MemoryMode::Monotonic})
+    {
+        std::string name = std::string("TaskManager (") + BoardMemory::modeName(mode) + ")";
+        reportResident(name.c_str(), count, [count, mode]
+                       {
+            auto manager = std::make_unique<TaskManager>(mode);
+            manager->reserve(count, 0);
+            for (size_t i = 0; i < count; ++i)
+                manager->addTask(makeTask(i));
+            std::printf("  manager's own report: %s\n", manager->getMemoryStats().toJson().c_str());
+            return manager; });
+    }
+
+    reportResident("CompactTaskStore", count, [count]
+                   {
+        auto store = std::make_unique<CompactTaskStore>();
+        for (size_t i = 0; i < count; ++i)
+            store->add(makeTask(i));
+        std::printf("  store's own report: %s\n", store->memoryReport().toJson().c_str());
+        return store; });
+
+    reportResident("CompactTaskStore (no interning)", count, [count]
+                   {
+        auto store = std::make_unique<CompactTaskStore>(false);
+        for (size_t i = 0; i < count; ++i)
+            store->add(makeTask(i));
+        return store; });
+
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    bool memory = argc > 1 && std::string(argv[1]) == "--memory";
+    int countArg = memory ? 2 : 1;
+    size_t count = argc > countArg ? std::strtoul(argv[countArg], nullptr, 10) : 100000;
+
+    if (memory)
+        return memoryReport(count);
+
+    std::vector<Task> batch;
+    batch.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        batch.push_back(makeTask(i));
+    }
+
+    TaskManager manager;
+    manager.addTasks(std::move(batch));
+    std::vector<Task> board = manager.getAllTasks();
+    const std::string needle = "Quarterly planning item #4242";
+
+    std::printf("Board of %zu tasks\n\n", board.size());
+
+    measure("find_if by title (copying)", [&]
+            { return static_cast<size_t>(std::count_if(board.begin(), board.end(), [&](const Task &task)
+                                                       { return copyOf(task.getTitle()) == needle; })); });
+    measure("find_if by title (reference)", [&]
+            { return static_cast<size_t>(std::count_if(board.begin(), board.end(), [&](const Task &task)
+                                                       { return task.getTitle() == needle; })); });
+
+    std::vector<const Task *> order;
+    order.reserve(board.size());
+    for (const Task &task : board)
+        order.push_back(&task);
+
+    measure("sort by title (copying)", [&]
+            {
+        std::vector<const Task *> sorted = order;
+        std::sort(sorted.begin(), sorted.end(), [](const Task *a, const Task *b)
+                  { return copyOf(a->getTitle()) < copyOf(b->getTitle()); });
+        return sorted.size(); });
+    measure("sort by title (reference)", [&]
+            {
+        std::vector<const Task *> sorted = order;
+        std::sort(sorted.begin(), sorted.end(), [](const Task *a, const Task *b)
+                  { return a->getTitle() < b->getTitle(); });
+        return sorted.size(); });
+
+    measure("findTasksByTitle x1000", [&]
+            {
+        size_t found = 0;
+        for (int i = 0; i < 1000; ++i)
+            found += manager.findTasksByTitle(needle).size();
+        return found; });
+
+    measure("markTaskCompleted by title x1000", [&]
+            {
+        size_t marked = 0;
+        for (int i = 0; i < 1000; ++i)
+            marked += manager.markTaskCompleted("Quarterly planning item #" + std::to_string(i)) ? 1 : 0;
+        return marked; });
+
+    std::vector<Task> current = manager.getAllTasks();
+    measure("completed count from records x100", [&]
+            {
+        size_t completed = 0;
+        for (int i = 0; i < 100; ++i)
+            completed += static_cast<size_t>(std::count_if(current.begin(), current.end(), [](const Task &task)
+                                                           { return task.isCompleted(); }));
+        return completed; });
+    measure("getTaskCounts from bitmaps x100", [&]
+            {
+        size_t completed = 0;
+        for (int i = 0; i < 100; ++i)
+            completed += manager.getTaskCounts().completed;
+        return completed; });
+    measure("getPendingTasks", [&]
+            { return manager.getPendingTasks().size(); });
+
+    measure("field visitor over every task", [&]
+            {
+        size_t textBytes = 0;
+        for (const Task &task : board)
+        {
+            task.visitFields([&textBytes](const char *, const auto &value)
+                             {
+                if constexpr (std::is_same_v<std::decay_t<decltype(value)>, std::string_view>)
+                    textBytes += value.size(); });
+        }
+        return textBytes; });
+
+    measure("renderBoard", [&]
+            { return TaskHtml::renderBoard(board).size(); });
+
+    return 0;
+}
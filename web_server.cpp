@@ -1,9 +1,7 @@
-<<<<<<< HEAD
 #include <iostream>
 #include <string>
-#include <sstream>
 #include <thread>
-#include <map>
+#include <charconv>
 #include <regex>
 
 #ifdef _WIN32
@@ -12,178 +10,134 @@
 #pragma comment(lib, "ws2_32.lib")
 #else
 #include <sys/socket.h>
+#include <sys/time.h>
 #include <netinet/in.h>
 #include <unistd.h>
 #endif
 
-#include "TaskManager.h"
+#include "BoardRegistry.h"
+#include "TaskCommandActor.h"
+#include "TaskHtml.h"
+#include "EpollReactor.h"
+#include "HttpMessage.h"
+#include "FormFields.h"
+#include "HttpRequestParser.h"
+#include "Router.h"
+#include "WorkerPool.h"
+
+// Startup configuration, filled from the command line
+struct ServerOptions
+{
+    bool actorMode = false;                    // Apply mutations on one owner thread (--actor)
+    MemoryMode boardMemory = MemoryMode::Heap; // Allocation strategy of every board (--memory=)
+    size_t reactorLoops = 0;                   // epoll event loops; 0 = one thread per connection (--reactor)
+    size_t workers = 0;                        // Request worker threads; 0 = none (--workers)
+    size_t queueLimit = 256;                   // Jobs each worker may have queued before 503s (--queue-limit=)
+    KeepAlivePolicy keepAlive;                 // (--keep-alive-timeout=, --max-requests=)
+};
 
 class SimpleHttpServer
 {
 private:
     int port;
-    TaskManager taskManager;
-
-#ifdef _WIN32
-    SOCKET server_socket;
-#else
-    int server_socket;
-#endif
+    ServerOptions options;
+    BoardRegistry boards; // One task board per team, shared by every client thread
 
-    std::string urlDecode(const std::string &str)
-    {
-        std::string result;
-        std::istringstream iss(str);
-        char c;
-        while (iss >> c)
-        {
-            if (c == '%')
-            {
-                int hex;
-                iss >> std::hex >> hex;
-                result += static_cast<char>(hex);
-            }
-            else if (c == '+')
-            {
-                result += ' ';
-            }
-            else
-            {
-                result += c;
-            }
-        }
-        return result;
-    }
+    // Board behind the un-prefixed routes (/, /tasks, ...)
+    static constexpr const char *DEFAULT_BOARD = "default";
+    SharedTaskManager *defaultBoard = nullptr; // Cached so bare routes skip the registry
 
-    std::map<std::string, std::string> parseFormData(const std::string &data)
-    {
-        std::map<std::string, std::string> params;
-        std::istringstream iss(data);
-        std::string pair;
+    // Set in actor mode: mutations go through one owner thread instead of each
+    // connection thread taking the board's write lock
+    std::unique_ptr<TaskCommandActor> actor;
 
-        while (std::getline(iss, pair, '&'))
-        {
-            size_t pos = pair.find('=');
-            if (pos != std::string::npos)
-            {
-                std::string key = urlDecode(pair.substr(0, pos));
-                std::string value = urlDecode(pair.substr(pos + 1));
-                params[key] = value;
-            }
-        }
-        return params;
-    }
+    // Set when --workers is given: requests run on this fixed pool instead of a
+    // thread per connection (or on the event loop threads)
+    std::unique_ptr<WorkerPool> workers;
 
-    std::string generateTaskHtml(const std::vector<Task> &regularTasks, const std::deque<Task> &urgentTasks)
+    // What a route handler gets: the request, the path parameters and the query
+    // fields, all views into the connection's buffer
+    struct RequestContext
     {
-        std::ostringstream html;
+        const HttpRequest &request;
+        std::string_view path; // Target without the query string
+        RouteParams params;
+        FormFields query;
+        FormFields formFields;
+        bool formParsed = false;
 
-        html << "<div id=\"task-list\" class=\"kanban-board\">";
+        explicit RequestContext(const HttpRequest &request) : request(request) {}
 
-        // Kanban columns container
-        html << "<div class=\"kanban-columns\">";
-
-        // Urgent tasks column
-        html << "<div class=\"kanban-column urgent-column\">";
-        html << "<div class=\"column-header urgent-header\">";
-        html << "<h3>🚨 Urgent Tasks</h3>";
-        html << "<span class=\"container-type\">(using std::deque)</span>";
-        html << "<span class=\"task-count\">" << urgentTasks.size() << " tasks</span>";
-        html << "</div>";
-        html << "<div class=\"column-content\">";
-
-        if (!urgentTasks.empty())
+        // Fields of a form-encoded body, decoded in place on first use
+        const FormFields &form()
         {
-            for (const auto &task : urgentTasks)
+            if (!formParsed)
             {
-                html << "<div class=\"task-card urgent-task\">";
-                html << "<div class=\"task-header\">";
-                html << "<h4>" << task.getTitle() << "</h4>";
-                html << "<span class=\"priority priority-" << task.getPriority() << "\">P" << task.getPriority() << "</span>";
-                html << "</div>";
-                html << "<p class=\"task-description\">" << task.getDescription() << "</p>";
-                html << "<div class=\"task-meta\">";
-                html << "<span class=\"due-date\">📅 " << task.getDueDateString() << "</span>";
-                html << "<span class=\"status " << (task.isCompleted() ? "completed" : "pending") << "\">";
-                html << (task.isCompleted() ? "✅ Done" : "⏳ Active") << "</span>";
-                html << "</div>";
-                html << "<div class=\"task-actions\">";
-                if (!task.isCompleted())
-                {
-                    html << "<button hx-post=\"/complete-task\" hx-vals='{\"id\":" << task.getId() << "}' hx-target=\"#task-list\" class=\"action-btn complete-btn\">✓ Complete</button>";
-                }
-                html << "<button hx-post=\"/delete-task\" hx-vals='{\"id\":" << task.getId() << "}' hx-target=\"#task-list\" class=\"action-btn delete-btn\">🗑️ Delete</button>";
-                html << "</div>";
-                html << "</div>";
+                formFields.parse(HttpRequest::writable(request.body), request.body.size());
+                formParsed = true;
             }
+            return formFields;
         }
-        else
-        {
-            html << "<div class=\"empty-column\">No urgent tasks</div>";
-        }
-        html << "</div></div>";
+    };
 
-        // Regular tasks column
-        html << "<div class=\"kanban-column regular-column\">";
-        html << "<div class=\"column-header regular-header\">";
-        html << "<h3>📝 Regular Tasks</h3>";
-        html << "<span class=\"container-type\">(using std::vector)</span>";
-        html << "<span class=\"task-count\">" << regularTasks.size() << " tasks</span>";
-        html << "</div>";
-        html << "<div class=\"column-content\">";
+    using RouteHandler = std::function<std::string(RequestContext &context)>;
+    using BoardRouteHandler = std::function<std::string(RequestContext &context, SharedTaskManager &board)>;
+    Router<RouteHandler> router; // Built once in the constructor
 
-        if (!regularTasks.empty())
-        {
-            for (const auto &task : regularTasks)
-            {
-                html << "<div class=\"task-card regular-task\">";
-                html << "<div class=\"task-header\">";
-                html << "<h4>" << task.getTitle() << "</h4>";
-                html << "<span class=\"priority priority-" << task.getPriority() << "\">P" << task.getPriority() << "</span>";
-                html << "</div>";
-                html << "<p class=\"task-description\">" << task.getDescription() << "</p>";
-                html << "<div class=\"task-meta\">";
-                html << "<span class=\"due-date\">📅 " << task.getDueDateString() << "</span>";
-                html << "<span class=\"status " << (task.isCompleted() ? "completed" : "pending") << "\">";
-                html << (task.isCompleted() ? "✅ Done" : "⏳ Active") << "</span>";
-                html << "</div>";
-                html << "<div class=\"task-actions\">";
-                if (!task.isCompleted())
-                {
-                    html << "<button hx-post=\"/complete-task\" hx-vals='{\"id\":" << task.getId() << "}' hx-target=\"#task-list\" class=\"action-btn complete-btn\">✓ Complete</button>";
-                }
-                html << "<button hx-post=\"/delete-task\" hx-vals='{\"id\":" << task.getId() << "}' hx-target=\"#task-list\" class=\"action-btn delete-btn\">🗑️ Delete</button>";
-                html << "</div>";
-                html << "</div>";
-            }
-        }
-        else
-        {
-            html << "<div class=\"empty-column\">No regular tasks</div>";
-        }
-        html << "</div></div>";
+#ifdef _WIN32
+    SOCKET server_socket;
+#else
+    int server_socket;
+#endif
 
-        html << "</div>"; // Close kanban-columns
+    // The whole of 'text' as a number; false if it is empty or has anything else in it
+    template <typename Number>
+    static bool parseNumber(std::string_view text, Number &value)
+    {
+        const char *end = text.data() + text.size();
+        auto result = std::from_chars(text.data(), end, value);
+        return result.ec == std::errc() && result.ptr == end;
+    }
 
-        if (regularTasks.empty() && urgentTasks.empty())
-        {
-            html << "<div class=\"no-tasks\">🎯 Your Kanban board is empty! Add your first task above to get started.</div>";
-        }
+    // A priority within Task::MIN_PRIORITY..MAX_PRIORITY; false for anything else
+    static bool parsePriority(std::string_view text, int &priority)
+    {
+        return parseNumber(text, priority) && priority >= Task::MIN_PRIORITY && priority <= Task::MAX_PRIORITY;
+    }
 
-        html << "</div>"; // Close kanban-board
-        return html.str();
+    // Render the board straight from a snapshot (see TaskHtml.h)
+    std::string generateTaskHtml(const TaskSnapshot &snapshot)
+    {
+        return TaskHtml::renderBoard(snapshot.tasks());
     }
 
 public:
-    SimpleHttpServer(int p) : port(p)
+    SimpleHttpServer(int p, const ServerOptions &serverOptions = ServerOptions())
+        : port(p), options(serverOptions), boards(serverOptions.boardMemory)
     {
+        if (options.actorMode)
+            actor = std::make_unique<TaskCommandActor>();
+        if (options.workers > 0)
+            workers = std::make_unique<WorkerPool>(options.workers, options.queueLimit);
+
 #ifdef _WIN32
         WSADATA wsaData;
         WSAStartup(MAKEWORD(2, 2), &wsaData);
 #endif
+        // Never reissue task IDs from a previous run
+        if (!Task::ids().enablePersistence("task_ids.state"))
+        {
+            std::cerr << "Warning: cannot write task_ids.state; task IDs will restart on the next run" << std::endl;
+        }
+
+        defaultBoard = boards.getOrCreateBoard(DEFAULT_BOARD);
+        addRoutes();
+
         // Add some sample tasks
-        taskManager.addTask("Sample Task", "This is a sample regular task", "2025-01-15", 2, false);
-        taskManager.addTask("Urgent Bug Fix", "Critical production issue", "2025-01-10", 5, true);
+        defaultBoard->write([](TaskManager &tasks)
+                            {
+            tasks.addTask("Sample Task", "This is a sample regular task", "2025-01-15", 2, false);
+            tasks.addTask("Urgent Bug Fix", "Critical production issue", "2025-01-10", 5, true); });
     }
 
     ~SimpleHttpServer()
@@ -205,12 +159,27 @@ public:
         address.sin_addr.s_addr = INADDR_ANY;
         address.sin_port = htons(port);
 
+        // Allow a restart to rebind while old connections sit in TIME_WAIT
+        int reuse = 1;
+        setsockopt(server_socket, SOL_SOCKET, SO_REUSEADDR, (const char *)&reuse, sizeof(reuse));
+
         bind(server_socket, (struct sockaddr *)&address, sizeof(address));
-        listen(server_socket, 3);
+        listen(server_socket, SOMAXCONN);
 
         std::cout << "Task Manager Server running on http://localhost:" << port << std::endl;
         std::cout << "Visit the URL in your browser to access the task manager!" << std::endl;
 
+#ifdef __linux__
+        if (options.reactorLoops > 0)
+        {
+            std::cout << "Serving with " << options.reactorLoops << " epoll event loop(s)" << std::endl;
+            EpollReactor reactor(server_socket, options.reactorLoops, [this](const HttpRequest &request)
+                                 { return processRequest(request); }, workers.get(), options.keepAlive);
+            reactor.run();
+            return;
+        }
+#endif
+
         while (true)
         {
 #ifdef _WIN32
@@ -219,25 +188,110 @@ public:
             int client_socket = accept(server_socket, nullptr, nullptr);
 #endif
 
+            if (workers)
+            {
+                // Shed load rather than queue without bound
+                if (!workers->trySubmit([this, client_socket]
+                                        { handleClient(client_socket); }))
+                    rejectClient(client_socket);
+                continue;
+            }
+
             std::thread clientThread(&SimpleHttpServer::handleClient, this, client_socket);
             clientThread.detach();
         }
     }
 
 private:
+    // Answer 503 without reading the request, when every worker queue is full
+#ifdef _WIN32
+    void rejectClient(SOCKET client_socket)
+#else
+    void rejectClient(int client_socket)
+#endif
+    {
+        std::string response = getServiceUnavailable();
+        send(client_socket, response.c_str(), response.length(), 0);
+#ifdef _WIN32
+        closesocket(client_socket);
+#else
+        close(client_socket);
+#endif
+    }
+
 #ifdef _WIN32
     void handleClient(SOCKET client_socket){
 #else
     void handleClient(int client_socket)
     {
 #endif
-        char buffer[4096] = { 0 };
-    recv(client_socket, buffer, 4096, 0);
+        // An idle keep-alive connection is dropped when a receive times out
+        if (options.keepAlive.enabled())
+        {
+#ifdef _WIN32
+            DWORD timeout = static_cast<DWORD>(options.keepAlive.idleTimeout.count() * 1000);
+#else
+            timeval timeout{};
+            timeout.tv_sec = options.keepAlive.idleTimeout.count();
+#endif
+            setsockopt(client_socket, SOL_SOCKET, SO_RCVTIMEO, (const char *)&timeout, sizeof(timeout));
+        }
+
+        // Serve requests in the order they arrive until the client, the policy or
+        // a timeout ends the connection; pipelined requests wait in the parser.
+        // On the worker pool an idle connection would hold its worker in recv(),
+        // so there every response closes the connection instead.
+        bool keepAliveEnabled = options.keepAlive.enabled() && !workers;
+        HttpRequestParser parser;
+        size_t requestCount = 0;
+        bool keepOpen = true;
+        while (keepOpen)
+        {
+            HttpRequestParser::Status status;
+            while ((status = parser.parse()) == HttpRequestParser::Status::Incomplete)
+            {
+                // Receive straight into the parser's buffer, however large the request
+                char *space = parser.prepare(16384);
+                auto received = recv(client_socket, space, static_cast<int>(parser.writable()), 0);
+                if (received <= 0)
+                    break; // Closed by the client, failed, or timed out
+                parser.commit(static_cast<size_t>(received));
+            }
 
-    std::string request(buffer);
-    std::string response = processRequest(request);
+            std::string response;
+            if (status == HttpRequestParser::Status::Complete)
+            {
+                const HttpRequest &request = parser.request();
+                ++requestCount;
+                bool keepAliveAllowed = keepAliveEnabled && requestCount < options.keepAlive.maxRequests &&
+                                        request.wantsKeepAlive();
+
+                response = respond(request);
+                keepOpen = HttpMessage::finishResponse(response, keepAliveAllowed, options.keepAlive,
+                                                       options.keepAlive.maxRequests - requestCount);
+                parser.next();
+            }
+            else if (status == HttpRequestParser::Status::Error)
+            {
+                response = HttpMessage::errorResponse(parser.errorStatus());
+                keepOpen = false;
+            }
+            else
+            {
+                break;
+            }
 
-    send(client_socket, response.c_str(), response.length(), 0);
+            for (size_t sent = 0; sent < response.length();)
+            {
+                auto n = send(client_socket, response.c_str() + sent, static_cast<int>(response.length() - sent), 0);
+                if (n <= 0)
+                {
+                    keepOpen = false;
+                    break;
+                }
+                sent += static_cast<size_t>(n);
+            }
+        }
 
 #ifdef _WIN32
     closesocket(client_socket);
@@ -246,46 +300,118 @@ private:
 #endif
 }
 
-std::string
-processRequest(const std::string &request)
+// Handle one request, answering 500 if it throws, as EpollReactor::respond and
+// the worker pool do; an exception must not end the connection's thread
+std::string respond(const HttpRequest &request)
 {
-    std::istringstream iss(request);
-    std::string method, path, version;
-    iss >> method >> path >> version;
-
-    if (method == "GET" && path == "/")
+    try
     {
-        return getIndexPage();
+        return processRequest(request);
     }
-    else if (method == "GET" && path == "/tasks")
+    catch (const std::exception &e)
     {
-        return getTasksHtml();
+        std::cerr << "Request failed: " << e.what() << std::endl;
+        return HttpMessage::errorResponse(500);
     }
-    else if (method == "POST" && path == "/add-task")
-    {
-        return handleAddTask(request);
-    }
-    else if (method == "POST" && path == "/complete-task")
-    {
-        return handleCompleteTask(request);
-    }
-    else if (method == "POST" && path == "/delete-task")
-    {
-        return handleDeleteTask(request);
-    }
-    else if (method == "POST" && path == "/sort-tasks")
+}
+
+// Register a board route twice: bare for the default board, and under
+// /boards/<name> for a named one. Only POST routes create a named board; the
+// others look it up and answer 404 for a board that does not exist.
+void addBoardRoute(const char *method, const std::string &path, BoardRouteHandler handler)
+{
+    bool creates = std::string_view(method) == "POST";
+    router.add(method, path, [this, handler](RequestContext &context)
+               { return handler(context, *defaultBoard); });
+    router.add(method, "/boards/:board" + path, [this, handler, creates](RequestContext &context)
+               {
+        std::string name(context.params.get("board"));
+        SharedTaskManager *board = creates ? boards.getOrCreateBoard(name) : boards.findBoard(name);
+        return board ? handler(context, *board) : get404Page(); });
+}
+
+void addRoutes()
+{
+    router.add("GET", "/boards", [this](RequestContext &)
+               { return handleListBoards(); });
+    router.add("GET", "/stats/actor", [this](RequestContext &)
+               { return handleActorStats(); });
+    router.add("GET", "/stats/workers", [this](RequestContext &)
+               { return handleWorkerStats(); });
+    // A board's pages use relative URLs, so its root needs the trailing slash
+    router.add("", "/boards/:board", [this](RequestContext &context)
+               { return getRedirect(std::string(context.path) + "/"); });
+
+    // The page itself reads no tasks, so a new board's page is served before the
+    // board exists; its first change creates it
+    router.add("GET", "/", [this](RequestContext &)
+               { return getIndexPage("/"); });
+    router.add("GET", "/boards/:board/", [this](RequestContext &context)
+               {
+        std::string name(context.params.get("board"));
+        return BoardRegistry::isValidName(name) ? getIndexPage("/boards/" + name + "/") : get404Page(); });
+    addBoardRoute("GET", "/task/:id", [this](RequestContext &context, SharedTaskManager &board)
+                  { return handleGetTask(board, context.params.get("id")); });
+    addBoardRoute("GET", "/tasks", [this](RequestContext &context, SharedTaskManager &board)
+                  { return getTasksHtml(board, context.query.get("hide") == "completed"); });
+    addBoardRoute("GET", "/tasks/counts", [this](RequestContext &, SharedTaskManager &board)
+                  { return handleTaskCounts(board); });
+    addBoardRoute("POST", "/add-task", [this](RequestContext &context, SharedTaskManager &board)
+                  { return handleAddTask(board, context.form()); });
+    addBoardRoute("POST", "/tasks/batch", [this](RequestContext &context, SharedTaskManager &board)
+                  { return handleBatchAddTasks(board, context.request.body); });
+    addBoardRoute("POST", "/complete-task", [this](RequestContext &context, SharedTaskManager &board)
+                  { return handleCompleteTask(board, context.form()); });
+    addBoardRoute("POST", "/delete-task", [this](RequestContext &context, SharedTaskManager &board)
+                  { return handleDeleteTask(board, context.form()); });
+    addBoardRoute("POST", "/sort-tasks", [this](RequestContext &context, SharedTaskManager &board)
+                  { return handleSortTasks(board, context.form()); });
+    addBoardRoute("POST", "/clear-completed", [this](RequestContext &, SharedTaskManager &board)
+                  { return handleClearCompleted(board); });
+    addBoardRoute("GET", "/tasks/overdue", [this](RequestContext &, SharedTaskManager &board)
+                  { return handleOverdueTasks(board); });
+    addBoardRoute("GET", "/tasks/due-soon", [this](RequestContext &context, SharedTaskManager &board)
+                  { return handleTasksDueSoon(board, context.query); });
+    addBoardRoute("GET", "/urgent/next", [this](RequestContext &, SharedTaskManager &board)
+                  { return handleNextUrgentTask(board, false); });
+    addBoardRoute("POST", "/urgent/pop", [this](RequestContext &, SharedTaskManager &board)
+                  { return handleNextUrgentTask(board, true); });
+    addBoardRoute("GET", "/stats/locks", [this](RequestContext &, SharedTaskManager &board)
+                  { return handleLockStats(board); });
+    addBoardRoute("GET", "/stats/memory", [this](RequestContext &, SharedTaskManager &board)
+                  { return handleMemoryStats(board); });
+}
+
+std::string
+processRequest(const HttpRequest &request)
+{
+    RequestContext context(request);
+
+    // Split off the query string (e.g. /tasks/due-soon?hours=24)
+    std::string_view query;
+    context.path = request.target;
+    size_t queryStart = context.path.find('?');
+    if (queryStart != std::string_view::npos)
     {
-        return handleSortTasks(request);
+        query = context.path.substr(queryStart + 1);
+        context.path.remove_suffix(context.path.size() - queryStart);
     }
 
-    return get404Page();
+    const RouteHandler *handler = router.match(request.method, context.path, context.params);
+    if (!handler)
+        return get404Page();
+
+    context.query.parse(HttpRequest::writable(query), query.size());
+    return (*handler)(context);
 }
 
-std::string getIndexPage()
+// basePath is where the board lives; every htmx URL in the page is relative to it
+std::string getIndexPage(const std::string &basePath)
 {
     std::string html = R"(<!DOCTYPE html>
 <html lang="en">
 <head>
+    <base href=")" + basePath + R"(">
     <meta charset="UTF-8">
     <meta name="viewport" content="width=device-width, initial-scale=1.0">
     <title>C++ Task Manager - STL Sequential Containers Demo</title>
@@ -622,7 +748,7 @@ std::string getIndexPage()
 
         <div class="form-section">
             <h2>➕ Add New Task</h2>
-            <form hx-post="/add-task" hx-target="#task-list" hx-trigger="submit">
+            <form hx-post="add-task" hx-target="#task-list" hx-trigger="submit">
                 <div class="form-row">
                     <div class="form-group">
                         <label for="title">Task Title</label>
@@ -660,16 +786,17 @@ std::string getIndexPage()
 
         <div class="sort-controls">
             <h3>🔧 Sort Tasks</h3>
-            <button hx-post="/sort-tasks" hx-vals='{"sortBy":"priority"}' hx-target="#task-list" class="btn">Sort by Priority</button>
-            <button hx-post="/sort-tasks" hx-vals='{"sortBy":"dueDate"}' hx-target="#task-list" class="btn">Sort by Due Date</button>
-            <button hx-post="/sort-tasks" hx-vals='{"sortBy":"title"}' hx-target="#task-list" class="btn">Sort by Title</button>
+            <button hx-post="sort-tasks" hx-vals='{"sortBy":"priority"}' hx-target="#task-list" class="btn">Sort by Priority</button>
+            <button hx-post="sort-tasks" hx-vals='{"sortBy":"dueDate"}' hx-target="#task-list" class="btn">Sort by Due Date</button>
+            <button hx-post="sort-tasks" hx-vals='{"sortBy":"title"}' hx-target="#task-list" class="btn">Sort by Title</button>
+            <button hx-post="clear-completed" hx-target="#task-list" class="btn">Clear Completed</button>
         </div>
 
         <div class="container-info">
             <strong>💡 Container Usage:</strong> Regular tasks are stored in a std::vector for efficient sequential access and fast end insertions. Urgent tasks use std::deque to allow fast insertion at both front and back.
         </div>
 
-        <div hx-get="/tasks" hx-trigger="load" hx-target="this">
+        <div hx-get="tasks" hx-trigger="load" hx-target="this">
             Loading tasks...
         </div>
     </div>
@@ -680,765 +807,375 @@ std::string getIndexPage()
            std::to_string(html.length()) + "\r\n\r\n" + html;
 }
 
-std::string getTasksHtml()
+std::string getTasksHtml(SharedTaskManager &board, bool hideCompleted = false)
 {
-    std::vector<Task> regularTasks;
-    std::deque<Task> urgentTasks;
-
-    // Get tasks from manager (we need to access private members)
-    // For now, we'll use the getAllTasksJson and parse or create a simplified version
-    auto allTasks = taskManager.getAllTasks();
-
-    // Separate into regular and urgent based on priority
-    for (const auto &task : allTasks)
+    std::string html;
+    if (hideCompleted)
     {
-        if (task.getPriority() >= 4)
-        {
-            urgentTasks.push_back(task);
-        }
-        else
-        {
-            regularTasks.push_back(task);
-        }
+        // Filtered from the completion bitmap under a shared lock
+        html = TaskHtml::renderBoard(board.read([](const TaskManager &tasks)
+                                                { return tasks.getPendingTasks(); }));
+    }
+    else
+    {
+        // Render the current snapshot; rendering holds no lock, so writers never wait on it
+        std::shared_ptr<const TaskSnapshot> snapshot = board.snapshot();
+        html = generateTaskHtml(*snapshot);
     }
-
-    std::string html = generateTaskHtml(regularTasks, urgentTasks);
 
     return "HTTP/1.1 200 OK\r\nContent-Type: text/html\r\nContent-Length: " +
            std::to_string(html.length()) + "\r\n\r\n" + html;
 }
 
-std::string handleAddTask(const std::string &request)
+// Apply a mutation to a board and wait until it is visible in the board's snapshot
+void mutate(SharedTaskManager &board, TaskCommandActor::Mutation change)
 {
-    // Extract form data from POST body
-    size_t bodyStart = request.find("\r\n\r\n");
-    if (bodyStart == std::string::npos)
-        return get404Page();
+    if (actor)
+        actor->submit(board, std::move(change)).get();
+    else
+        board.write(change);
+}
+
+std::string handleAddTask(SharedTaskManager &board, const FormFields &form)
+{
+    int priority;
+    if (!parsePriority(form.get("priority"), priority))
+        return HttpMessage::errorResponse(400);
+
+    std::string title(form.get("title"));
+    std::string description(form.get("description"));
+    std::string dueDate(form.get("dueDate"));
+    bool isUrgent = form.contains("isUrgent");
+
+    mutate(board, [&](TaskManager &tasks)
+                  { tasks.addTask(title, description, dueDate, priority, isUrgent); });
+
+    return getTasksHtml(board);
+}
+
+// Bulk import: one task per body line as tab-separated
+// title, description, dueDate (YYYY-MM-DD), priority (1-5) and an optional urgent flag (1/true).
+// Malformed lines, including out-of-range priorities, are skipped; the rest are added in one write.
+std::string handleBatchAddTasks(SharedTaskManager &board, std::string_view body)
+{
+    std::vector<Task> regular;
+    std::vector<Task> urgent;
+    size_t skipped = 0;
+
+    // Lines are views into the request body; only the fields a Task keeps are copied
+    for (size_t lineStart = 0; lineStart < body.size();)
+    {
+        size_t lineEnd = body.find('\n', lineStart);
+        if (lineEnd == std::string_view::npos)
+            lineEnd = body.size();
+        std::string_view line = body.substr(lineStart, lineEnd - lineStart);
+        lineStart = lineEnd + 1;
+
+        if (!line.empty() && line.back() == '\r')
+            line.remove_suffix(1);
+        if (line.empty())
+            continue;
+
+        std::string_view fields[5];
+        size_t count = 0;
+        size_t start = 0;
+        while (count < 5)
+        {
+            size_t tab = line.find('\t', start);
+            fields[count++] = line.substr(start, tab == std::string_view::npos ? std::string_view::npos : tab - start);
+            if (tab == std::string_view::npos)
+                break;
+            start = tab + 1;
+        }
 
-    std::string body = request.substr(bodyStart + 4);
-    auto params = parseFormData(body);
+        int priority = 0;
+        if (count < 4 || fields[0].empty() || !parsePriority(fields[3], priority))
+        {
+            ++skipped;
+            continue;
+        }
 
-    std::string title = params["title"];
-    std::string description = params["description"];
-    std::string dueDate = params["dueDate"];
-    int priority = std::stoi(params["priority"]);
-    bool isUrgent = params.find("isUrgent") != params.end();
+        bool isUrgent = count == 5 && (fields[4] == "1" || fields[4] == "true");
+        std::int32_t dueDay = TaskManager::dueDayOrToday(std::string(fields[2]));
+        (isUrgent ? urgent : regular).emplace_back(std::string(fields[0]), std::string(fields[1]), dueDay, priority);
+    }
 
-    taskManager.addTask(title, description, dueDate, priority, isUrgent);
+    size_t added = regular.size() + urgent.size();
+    mutate(board, [&regular, &urgent](TaskManager &tasks)
+                  {
+        tasks.addTasks(std::move(regular));
+        tasks.addUrgentTasks(std::move(urgent)); });
 
-    return getTasksHtml();
+    return getJsonResponse("{\"added\":" + std::to_string(added) + ",\"skipped\":" + std::to_string(skipped) + "}");
 }
 
-std::string handleCompleteTask(const std::string &request)
+std::string handleCompleteTask(SharedTaskManager &board, const FormFields &form)
 {
-    size_t bodyStart = request.find("\r\n\r\n");
-    if (bodyStart == std::string::npos)
-        return get404Page();
+    TaskId id;
+    if (!parseNumber(form.get("id"), id))
+        return HttpMessage::errorResponse(400);
+    mutate(board, [id](TaskManager &tasks)
+                  { tasks.markTaskCompleted(id); });
 
-    std::string body = request.substr(bodyStart + 4);
-    auto params = parseFormData(body);
+    return getTasksHtml(board);
+}
 
-    int id = std::stoi(params["id"]);
-    taskManager.markTaskCompleted(id);
+std::string handleDeleteTask(SharedTaskManager &board, const FormFields &form)
+{
+    TaskId id;
+    if (!parseNumber(form.get("id"), id))
+        return HttpMessage::errorResponse(400);
+    mutate(board, [id](TaskManager &tasks)
+                  { tasks.removeAnyTaskById(id); });
 
-    return getTasksHtml();
+    return getTasksHtml(board);
 }
 
-std::string handleDeleteTask(const std::string &request)
+std::string handleSortTasks(SharedTaskManager &board, const FormFields &form)
 {
-    size_t bodyStart = request.find("\r\n\r\n");
-    if (bodyStart == std::string::npos)
-        return get404Page();
+    std::string_view sortBy = form.get("sortBy");
 
-    std::string body = request.substr(bodyStart + 4);
-    auto params = parseFormData(body);
+    mutate(board, [&](TaskManager &tasks)
+                  {
+        if (sortBy == "priority")
+        {
+            tasks.sortTasksByPriority();
+        }
+        else if (sortBy == "dueDate")
+        {
+            tasks.sortTasksByDueDate();
+        }
+        else if (sortBy == "title")
+        {
+            tasks.sortTasksByTitle();
+        } });
 
-    int id = std::stoi(params["id"]);
-    taskManager.removeTaskById(id);
-    taskManager.removeUrgentTaskById(id);
+    return getTasksHtml(board);
+}
 
-    return getTasksHtml();
+std::string handleClearCompleted(SharedTaskManager &board)
+{
+    mutate(board, [](TaskManager &tasks)
+                  { tasks.removeCompletedTasks(); });
+    return getTasksHtml(board);
 }
 
-std::string handleSortTasks(const std::string &request)
+// One task as JSON, read from the board's lock-free ID map
+std::string handleGetTask(SharedTaskManager &board, std::string_view idText)
 {
-    size_t bodyStart = request.find("\r\n\r\n");
-    if (bodyStart == std::string::npos)
+    TaskId id;
+    if (!parseNumber(idText, id))
         return get404Page();
 
-    std::string body = request.substr(bodyStart + 4);
-    auto params = parseFormData(body);
+    std::string json;
+    if (!board.readTask(id, [&json](const Task &task)
+                        { json = task.toJson(); }))
+        return get404Page();
 
-    std::string sortBy = params["sortBy"];
+    return getJsonResponse(json);
+}
 
-    if (sortBy == "priority")
-    {
-        taskManager.sortTasksByPriority();
-    }
-    else if (sortBy == "dueDate")
+// Most urgent pending task as JSON; optionally removes it for a dispatcher
+std::string handleNextUrgentTask(SharedTaskManager &board, bool pop)
+{
+    std::string json = "null";
+    if (pop)
     {
-        taskManager.sortTasksByDueDate();
+        std::optional<Task> next;
+        mutate(board, [&next](TaskManager &tasks)
+                      { next = tasks.popNextUrgentTask(); });
+        if (next)
+            json = next->toJson();
     }
-    else if (sortBy == "title")
+    else
     {
-        taskManager.sortTasksByTitle();
+        // The pointer is only valid while the lock is held, so serialize inside
+        board.read([&](const TaskManager &tasks)
+                   {
+            if (const Task *next = tasks.peekNextUrgentTask())
+                json = next->toJson(); });
     }
 
-    return getTasksHtml();
+    return getJsonResponse(json);
 }
 
-std::string get404Page()
+// Pending tasks past their due date, earliest first
+std::string handleOverdueTasks(SharedTaskManager &board)
 {
-    std::string html = "<h1>404 Not Found</h1>";
-    return "HTTP/1.1 404 Not Found\r\nContent-Type: text/html\r\nContent-Length: " +
-           std::to_string(html.length()) + "\r\n\r\n" + html;
+    auto now = std::chrono::system_clock::now();
+    return getJsonResponse(board.read([now](const TaskManager &tasks)
+                                      { return tasksToJson(tasks.getOverdueTasks(now)); }));
 }
+
+// Pending tasks due in the next ?hours= hours (default 24), earliest first
+std::string handleTasksDueSoon(SharedTaskManager &board, const FormFields &query)
+{
+    int hours = 24;
+    int requested;
+    if (parseNumber(query.get("hours"), requested) && requested > 0)
+        hours = requested;
+
+    auto now = std::chrono::system_clock::now();
+    return getJsonResponse(board.read([now, hours](const TaskManager &tasks)
+                                      { return tasksToJson(tasks.getTasksDueWithin(now, std::chrono::hours(hours))); }));
 }
-;
 
-int main()
+// Batching counters for actor mode (null when it is off)
+std::string handleActorStats()
 {
-    SimpleHttpServer server(8080);
-    server.start();
-    return 0;
-=======
-#include <iostream>
-#include <string>
-#include <sstream>
-#include <thread>
-#include <map>
-#include <regex>
+    return getJsonResponse(actor ? actor->getStats().toJson() : "null");
+}
 
-#ifdef _WIN32
-#include <winsock2.h>
-#include <ws2tcpip.h>
-#pragma comment(lib, "ws2_32.lib")
-#else
-#include <sys/socket.h>
-#include <netinet/in.h>
-#include <unistd.h>
-#endif
+std::string handleWorkerStats()
+{
+    return getJsonResponse(workers ? workers->getStats().toJson() : "null");
+}
 
-#include "TaskManager.h"
+// Names of every board as a JSON array
+std::string handleListBoards()
+{
+    std::string json = "[";
+    bool first = true;
+    for (const std::string &name : boards.getBoardNames())
+    {
+        if (!first)
+            json += ",";
+        first = false;
+        json += "\"" + name + "\"";
+    }
+    json += "]";
+    return getJsonResponse(json);
+}
 
-class SimpleHttpServer
+// Reader/writer lock counters for the shared task manager
+std::string handleLockStats(SharedTaskManager &board)
 {
-private:
-    int port;
-    TaskManager taskManager;
+    return getJsonResponse(board.getLockStats().toJson());
+}
 
-#ifdef _WIN32
-    SOCKET server_socket;
-#else
-    int server_socket;
-#endif
+// Status bar totals, counted from the board's flag bitmaps
+std::string handleTaskCounts(SharedTaskManager &board)
+{
+    return getJsonResponse(board.read([](const TaskManager &tasks)
+                                      { return tasks.getTaskCounts().toJson(); }));
+}
+
+// Allocation counters of the board's containers and of the blocks backing them
+std::string handleMemoryStats(SharedTaskManager &board)
+{
+    return getJsonResponse(board.read([](const TaskManager &tasks)
+                                      { return tasks.getMemoryStats().toJson(); }));
+}
 
-    std::string urlDecode(const std::string &str)
+static std::string tasksToJson(const std::vector<const Task *> &matches)
+{
+    std::string json = "[";
+    for (size_t i = 0; i < matches.size(); ++i)
     {
-        std::string result;
-        std::istringstream iss(str);
-        char c;
-        while (iss >> c)
-        {
-            if (c == '%')
-            {
-                int hex;
-                iss >> std::hex >> hex;
-                result += static_cast<char>(hex);
-            }
-            else if (c == '+')
-            {
-                result += ' ';
-            }
-            else
-            {
-                result += c;
-            }
-        }
-        return result;
+        if (i > 0)
+            json += ",";
+        json += matches[i]->toJson();
     }
+    json += "]";
+    return json;
+}
 
-    std::map<std::string, std::string> parseFormData(const std::string &data)
-    {
-        std::map<std::string, std::string> params;
-        std::istringstream iss(data);
-        std::string pair;
+std::string getJsonResponse(const std::string &json)
+{
+    return "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\nContent-Length: " +
+           std::to_string(json.length()) + "\r\n\r\n" + json;
+}
 
-        while (std::getline(iss, pair, '&'))
-        {
-            size_t pos = pair.find('=');
-            if (pos != std::string::npos)
-            {
-                std::string key = urlDecode(pair.substr(0, pos));
-                std::string value = urlDecode(pair.substr(pos + 1));
-                params[key] = value;
-            }
-        }
-        return params;
-    }
+std::string getRedirect(const std::string &location)
+{
+    return "HTTP/1.1 301 Moved Permanently\r\nLocation: " + location + "\r\nContent-Length: 0\r\n\r\n";
+}
 
-    std::string generateTaskHtml(const std::vector<Task> &regularTasks, const std::deque<Task> &urgentTasks)
-    {
-        std::ostringstream html;
+// Sent when the worker queues are full; clients should retry after a second
+std::string getServiceUnavailable()
+{
+    return "HTTP/1.1 503 Service Unavailable\r\nRetry-After: 1\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+}
 
-        html << "<div id=\"task-list\">";
+std::string get404Page()
+{
+    std::string html = "<h1>404 Not Found</h1>";
+    return "HTTP/1.1 404 Not Found\r\nContent-Type: text/html\r\nContent-Length: " +
+           std::to_string(html.length()) + "\r\n\r\n" + html;
+}
+}
+;
 
-        // Urgent tasks
-        if (!urgentTasks.empty())
+int main(int argc, char *argv[])
+{
+    // --actor: apply every mutation on a single owner thread, in batches
+    // --memory=heap|pool|monotonic: allocation strategy for each board's containers
+    // --reactor[=N]: serve connections from N epoll event loops (default: one per core; Linux only)
+    // --workers[=N]: handle requests on a fixed pool of N workers (default: one per core)
+    // --queue-limit=N: jobs each worker may have waiting before new requests get 503
+    // --keep-alive-timeout=S: close connections idle for S seconds (0 turns keep-alive off)
+    // --max-requests=N: close a connection after N requests
+    ServerOptions options;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        bool ok = true;
+        if (arg == "--actor")
         {
-            html << "<h3 class=\"urgent-header\">🚨 Urgent Tasks (using deque)</h3>";
-            for (const auto &task : urgentTasks)
-            {
-                html << "<div class=\"task-item urgent-task\">";
-                html << "<div class=\"task-header\">";
-                html << "<h4>" << task.getTitle() << "</h4>";
-                html << "<span class=\"priority\">Priority: " << task.getPriority() << "</span>";
-                html << "</div>";
-                html << "<p>" << task.getDescription() << "</p>";
-                html << "<div class=\"task-meta\">";
-                html << "<span>Due: " << task.getDueDateString() << "</span>";
-                html << "<span class=\"status " << (task.isCompleted() ? "completed" : "pending") << "\">";
-                html << (task.isCompleted() ? "✓ Completed" : "⏳ Pending") << "</span>";
-                html << "</div>";
-                html << "<div class=\"task-actions\">";
-                if (!task.isCompleted())
-                {
-                    html << "<button hx-post=\"/complete-task\" hx-vals='{\"id\":" << task.getId() << "}' hx-target=\"#task-list\" class=\"complete-btn\">Complete</button>";
-                }
-                html << "<button hx-post=\"/delete-task\" hx-vals='{\"id\":" << task.getId() << "}' hx-target=\"#task-list\" class=\"delete-btn\">Delete</button>";
-                html << "</div></div>";
-            }
+            options.actorMode = true;
         }
-
-        // Regular tasks
-        if (!regularTasks.empty())
+        else if (arg.rfind("--memory=", 0) == 0)
         {
-            html << "<h3 class=\"regular-header\">📝 Regular Tasks (using vector)</h3>";
-            for (const auto &task : regularTasks)
-            {
-                html << "<div class=\"task-item regular-task\">";
-                html << "<div class=\"task-header\">";
-                html << "<h4>" << task.getTitle() << "</h4>";
-                html << "<span class=\"priority\">Priority: " << task.getPriority() << "</span>";
-                html << "</div>";
-                html << "<p>" << task.getDescription() << "</p>";
-                html << "<div class=\"task-meta\">";
-                html << "<span>Due: " << task.getDueDateString() << "</span>";
-                html << "<span class=\"status " << (task.isCompleted() ? "completed" : "pending") << "\">";
-                html << (task.isCompleted() ? "✓ Completed" : "⏳ Pending") << "</span>";
-                html << "</div>";
-                html << "<div class=\"task-actions\">";
-                if (!task.isCompleted())
-                {
-                    html << "<button hx-post=\"/complete-task\" hx-vals='{\"id\":" << task.getId() << "}' hx-target=\"#task-list\" class=\"complete-btn\">Complete</button>";
-                }
-                html << "<button hx-post=\"/delete-task\" hx-vals='{\"id\":" << task.getId() << "}' hx-target=\"#task-list\" class=\"delete-btn\">Delete</button>";
-                html << "</div></div>";
-            }
+            ok = BoardMemory::parseMode(arg.substr(9), options.boardMemory);
         }
-
-        if (regularTasks.empty() && urgentTasks.empty())
+#ifdef __linux__
+        else if (arg == "--reactor")
         {
-            html << "<div class=\"no-tasks\">No tasks yet. Add your first task above!</div>";
+            options.reactorLoops = EpollReactor::defaultLoopCount();
+        }
+        else if (arg.rfind("--reactor=", 0) == 0)
+        {
+            options.reactorLoops = std::strtoul(arg.c_str() + 10, nullptr, 10);
+            ok = options.reactorLoops > 0;
         }
-
-        html << "</div>";
-        return html.str();
-    }
-
-public:
-    SimpleHttpServer(int p) : port(p)
-    {
-#ifdef _WIN32
-        WSADATA wsaData;
-        WSAStartup(MAKEWORD(2, 2), &wsaData);
 #endif
-        // Add some sample tasks
-        taskManager.addTask("Sample Task", "This is a sample regular task", "2025-01-15", 2, false);
-        taskManager.addTask("Urgent Bug Fix", "Critical production issue", "2025-01-10", 5, true);
-    }
-
-    ~SimpleHttpServer()
-    {
-#ifdef _WIN32
-        closesocket(server_socket);
-        WSACleanup();
-#else
-        close(server_socket);
-#endif
-    }
-
-    void start()
-    {
-        server_socket = socket(AF_INET, SOCK_STREAM, 0);
-
-        sockaddr_in address;
-        address.sin_family = AF_INET;
-        address.sin_addr.s_addr = INADDR_ANY;
-        address.sin_port = htons(port);
-
-        bind(server_socket, (struct sockaddr *)&address, sizeof(address));
-        listen(server_socket, 3);
-
-        std::cout << "Task Manager Server running on http://localhost:" << port << std::endl;
-        std::cout << "Visit the URL in your browser to access the task manager!" << std::endl;
-
-        while (true)
+        else if (arg == "--workers")
         {
-#ifdef _WIN32
-            SOCKET client_socket = accept(server_socket, nullptr, nullptr);
-#else
-            int client_socket = accept(server_socket, nullptr, nullptr);
-#endif
-
-            std::thread clientThread(&SimpleHttpServer::handleClient, this, client_socket);
-            clientThread.detach();
-        }
-    }
-
-private:
-#ifdef _WIN32
-    void handleClient(SOCKET client_socket){
-#else
-    void handleClient(int client_socket)
-    {
-#endif
-        char buffer[4096] = { 0 };
-    recv(client_socket, buffer, 4096, 0);
-
-    std::string request(buffer);
-    std::string response = processRequest(request);
-
-    send(client_socket, response.c_str(), response.length(), 0);
-
-#ifdef _WIN32
-    closesocket(client_socket);
-#else
-        close(client_socket);
-#endif
-}
-
-std::string
-processRequest(const std::string &request)
-{
-    std::istringstream iss(request);
-    std::string method, path, version;
-    iss >> method >> path >> version;
-
-    if (method == "GET" && path == "/")
-    {
-        return getIndexPage();
-    }
-    else if (method == "GET" && path == "/tasks")
-    {
-        return getTasksHtml();
-    }
-    else if (method == "POST" && path == "/add-task")
-    {
-        return handleAddTask(request);
-    }
-    else if (method == "POST" && path == "/complete-task")
-    {
-        return handleCompleteTask(request);
-    }
-    else if (method == "POST" && path == "/delete-task")
-    {
-        return handleDeleteTask(request);
-    }
-    else if (method == "POST" && path == "/sort-tasks")
-    {
-        return handleSortTasks(request);
-    }
-
-    return get404Page();
-}
-
-std::string getIndexPage()
-{
-    std::string html = R"(<!DOCTYPE html>
-<html lang="en">
-<head>
-    <meta charset="UTF-8">
-    <meta name="viewport" content="width=device-width, initial-scale=1.0">
-    <title>C++ Task Manager - STL Sequential Containers Demo</title>
-    <script src="https://unpkg.com/htmx.org@1.9.10"></script>
-    <style>
-        * { margin: 0; padding: 0; box-sizing: border-box; }
-        body { 
-            font-family: 'Segoe UI', Tahoma, Geneva, Verdana, sans-serif;
-            background: linear-gradient(135deg, #667eea 0%, #764ba2 100%);
-            min-height: 100vh;
-            padding: 20px;
-        }
-        .container { 
-            max-width: 1200px; 
-            margin: 0 auto; 
-            background: white;
-            border-radius: 15px;
-            box-shadow: 0 20px 40px rgba(0,0,0,0.1);
-            overflow: hidden;
-        }
-        .header {
-            background: linear-gradient(135deg, #2c3e50 0%, #34495e 100%);
-            color: white;
-            padding: 30px;
-            text-align: center;
-        }
-        .header h1 { 
-            font-size: 2.5em; 
-            margin-bottom: 10px;
-            font-weight: 300;
-        }
-        .stl-info {
-            background: #f8f9fa;
-            padding: 20px;
-            border-left: 4px solid #3498db;
-            margin: 20px;
-            border-radius: 8px;
-        }
-        .stl-info h3 { color: #2c3e50; margin-bottom: 10px; }
-        .stl-info p { color: #7f8c8d; line-height: 1.6; }
-        .form-section {
-            padding: 30px;
-            background: #ffffff;
-        }
-        .form-row {
-            display: flex;
-            gap: 15px;
-            margin-bottom: 15px;
-            flex-wrap: wrap;
-        }
-        .form-group {
-            flex: 1;
-            min-width: 200px;
-        }
-        label {
-            display: block;
-            margin-bottom: 5px;
-            font-weight: 600;
-            color: #2c3e50;
-        }
-        input, textarea, select {
-            width: 100%;
-            padding: 12px;
-            border: 2px solid #e0e0e0;
-            border-radius: 8px;
-            font-size: 16px;
-            transition: border-color 0.3s ease;
-        }
-        input:focus, textarea:focus, select:focus {
-            outline: none;
-            border-color: #3498db;
-            box-shadow: 0 0 0 3px rgba(52, 152, 219, 0.1);
-        }
-        .btn {
-            background: linear-gradient(135deg, #3498db 0%, #2980b9 100%);
-            color: white;
-            padding: 12px 25px;
-            border: none;
-            border-radius: 8px;
-            cursor: pointer;
-            font-size: 16px;
-            font-weight: 600;
-            transition: all 0.3s ease;
-            margin-right: 10px;
-            margin-bottom: 10px;
-        }
-        .btn:hover {
-            transform: translateY(-2px);
-            box-shadow: 0 8px 20px rgba(52, 152, 219, 0.3);
-        }
-        .sort-controls {
-            background: #f8f9fa;
-            padding: 20px;
-            border-bottom: 1px solid #e0e0e0;
-            text-align: center;
-        }
-        .sort-controls h3 {
-            margin-bottom: 15px;
-            color: #2c3e50;
-        }
-        .task-item {
-            background: white;
-            margin: 15px 20px;
-            padding: 20px;
-            border-radius: 12px;
-            border-left: 4px solid #3498db;
-            box-shadow: 0 4px 15px rgba(0,0,0,0.08);
-            transition: all 0.3s ease;
-        }
-        .task-item:hover {
-            transform: translateY(-3px);
-            box-shadow: 0 8px 25px rgba(0,0,0,0.15);
+            options.workers = WorkerPool::defaultWorkerCount();
         }
-        .urgent-task { border-left-color: #e74c3c; }
-        .regular-task { border-left-color: #3498db; }
-        .task-header {
-            display: flex;
-            justify-content: space-between;
-            align-items: center;
-            margin-bottom: 10px;
-        }
-        .task-header h4 {
-            color: #2c3e50;
-            font-size: 1.3em;
-        }
-        .priority {
-            background: #ecf0f1;
-            padding: 5px 12px;
-            border-radius: 20px;
-            font-size: 0.9em;
-            font-weight: 600;
-            color: #2c3e50;
-        }
-        .task-meta {
-            display: flex;
-            justify-content: space-between;
-            margin: 15px 0;
-            font-size: 0.9em;
-            color: #7f8c8d;
-        }
-        .status.completed { color: #27ae60; font-weight: 600; }
-        .status.pending { color: #f39c12; font-weight: 600; }
-        .task-actions {
-            display: flex;
-            gap: 10px;
-            margin-top: 15px;
-        }
-        .complete-btn {
-            background: linear-gradient(135deg, #27ae60 0%, #2ecc71 100%);
-            color: white;
-            border: none;
-            padding: 8px 16px;
-            border-radius: 6px;
-            cursor: pointer;
-            font-size: 14px;
-        }
-        .delete-btn {
-            background: linear-gradient(135deg, #e74c3c 0%, #c0392b 100%);
-            color: white;
-            border: none;
-            padding: 8px 16px;
-            border-radius: 6px;
-            cursor: pointer;
-            font-size: 14px;
-        }
-        .urgent-header, .regular-header {
-            color: #2c3e50;
-            margin: 25px 20px 15px 20px;
-            font-size: 1.4em;
-            border-bottom: 2px solid #ecf0f1;
-            padding-bottom: 10px;
+        else if (arg.rfind("--workers=", 0) == 0)
+        {
+            options.workers = std::strtoul(arg.c_str() + 10, nullptr, 10);
+            ok = options.workers > 0;
         }
-        .no-tasks {
-            text-align: center;
-            color: #7f8c8d;
-            font-style: italic;
-            padding: 40px;
-            font-size: 1.1em;
+        else if (arg.rfind("--queue-limit=", 0) == 0)
+        {
+            options.queueLimit = std::strtoul(arg.c_str() + 14, nullptr, 10);
+            ok = options.queueLimit > 0;
         }
-        .container-info {
-            background: linear-gradient(135deg, #74b9ff 0%, #0984e3 100%);
-            color: white;
-            padding: 15px 20px;
-            margin: 0 20px 20px 20px;
-            border-radius: 8px;
+        else if (arg.rfind("--keep-alive-timeout=", 0) == 0)
+        {
+            options.keepAlive.idleTimeout = std::chrono::seconds(std::strtoul(arg.c_str() + 21, nullptr, 10));
         }
-    </style>
-</head>
-<body>
-    <div class="container">
-        <div class="header">
-            <h1>🚀 C++ Task Manager</h1>
-            <p>Demonstrating STL Sequential Containers: std::vector & std::deque</p>
-        </div>
-
-        <div class="stl-info">
-            <h3>📚 STL Sequential Containers in Action</h3>
-            <p><strong>std::vector&lt;Task&gt;</strong> - Used for regular tasks: Dynamic array with efficient random access and fast insertion at the end.</p>
-            <p><strong>std::deque&lt;Task&gt;</strong> - Used for urgent tasks: Double-ended queue allowing efficient insertion/removal at both front and back.</p>
-        </div>
-
-        <div class="form-section">
-            <h2>➕ Add New Task</h2>
-            <form hx-post="/add-task" hx-target="#task-list" hx-trigger="submit">
-                <div class="form-row">
-                    <div class="form-group">
-                        <label for="title">Task Title</label>
-                        <input type="text" id="title" name="title" required>
-                    </div>
-                    <div class="form-group">
-                        <label for="priority">Priority (1-5)</label>
-                        <select id="priority" name="priority" required>
-                            <option value="1">1 - Low</option>
-                            <option value="2">2 - Normal</option>
-                            <option value="3" selected>3 - Medium</option>
-                            <option value="4">4 - High</option>
-                            <option value="5">5 - Critical</option>
-                        </select>
-                    </div>
-                </div>
-                <div class="form-row">
-                    <div class="form-group">
-                        <label for="description">Description</label>
-                        <textarea id="description" name="description" rows="3" required></textarea>
-                    </div>
-                    <div class="form-group">
-                        <label for="dueDate">Due Date</label>
-                        <input type="date" id="dueDate" name="dueDate" required>
-                        <br><br>
-                        <label>
-                            <input type="checkbox" name="isUrgent" value="true"> 
-                            🚨 Mark as Urgent (use deque)
-                        </label>
-                    </div>
-                </div>
-                <button type="submit" class="btn">Add Task</button>
-            </form>
-        </div>
-
-        <div class="sort-controls">
-            <h3>🔧 Sort Tasks</h3>
-            <button hx-post="/sort-tasks" hx-vals='{"sortBy":"priority"}' hx-target="#task-list" class="btn">Sort by Priority</button>
-            <button hx-post="/sort-tasks" hx-vals='{"sortBy":"dueDate"}' hx-target="#task-list" class="btn">Sort by Due Date</button>
-            <button hx-post="/sort-tasks" hx-vals='{"sortBy":"title"}' hx-target="#task-list" class="btn">Sort by Title</button>
-        </div>
-
-        <div class="container-info">
-            <strong>💡 Container Usage:</strong> Regular tasks are stored in a std::vector for efficient sequential access and fast end insertions. Urgent tasks use std::deque to allow fast insertion at both front and back.
-        </div>
-
-        <div hx-get="/tasks" hx-trigger="load" hx-target="this">
-            Loading tasks...
-        </div>
-    </div>
-</body>
-</html>)";
-
-    return "HTTP/1.1 200 OK\r\nContent-Type: text/html\r\nContent-Length: " +
-           std::to_string(html.length()) + "\r\n\r\n" + html;
-}
-
-std::string getTasksHtml()
-{
-    std::vector<Task> regularTasks;
-    std::deque<Task> urgentTasks;
-
-    // Get tasks from manager (we need to access private members)
-    // For now, we'll use the getAllTasksJson and parse or create a simplified version
-    auto allTasks = taskManager.getAllTasks();
-
-    // Separate into regular and urgent based on priority
-    for (const auto &task : allTasks)
-    {
-        if (task.getPriority() >= 4)
+        else if (arg.rfind("--max-requests=", 0) == 0)
         {
-            urgentTasks.push_back(task);
+            options.keepAlive.maxRequests = std::strtoul(arg.c_str() + 15, nullptr, 10);
+            ok = options.keepAlive.maxRequests > 0;
         }
         else
         {
-            regularTasks.push_back(task);
+            ok = false;
         }
-    }
-
-    std::string html = generateTaskHtml(regularTasks, urgentTasks);
 
-    return "HTTP/1.1 200 OK\r\nContent-Type: text/html\r\nContent-Length: " +
-           std::to_string(html.length()) + "\r\n\r\n" + html;
-}
-
-std::string handleAddTask(const std::string &request)
-{
-    // Extract form data from POST body
-    size_t bodyStart = request.find("\r\n\r\n");
-    if (bodyStart == std::string::npos)
-        return get404Page();
-
-    std::string body = request.substr(bodyStart + 4);
-    auto params = parseFormData(body);
-
-    std::string title = params["title"];
-    std::string description = params["description"];
-    std::string dueDate = params["dueDate"];
-    int priority = std::stoi(params["priority"]);
-    bool isUrgent = params.find("isUrgent") != params.end();
-
-    taskManager.addTask(title, description, dueDate, priority, isUrgent);
-
-    return getTasksHtml();
-}
-
-std::string handleCompleteTask(const std::string &request)
-{
-    size_t bodyStart = request.find("\r\n\r\n");
-    if (bodyStart == std::string::npos)
-        return get404Page();
-
-    std::string body = request.substr(bodyStart + 4);
-    auto params = parseFormData(body);
-
-    int id = std::stoi(params["id"]);
-    taskManager.markTaskCompleted(id);
-
-    return getTasksHtml();
-}
-
-std::string handleDeleteTask(const std::string &request)
-{
-    size_t bodyStart = request.find("\r\n\r\n");
-    if (bodyStart == std::string::npos)
-        return get404Page();
-
-    std::string body = request.substr(bodyStart + 4);
-    auto params = parseFormData(body);
-
-    int id = std::stoi(params["id"]);
-    taskManager.removeTaskById(id);
-    taskManager.removeUrgentTaskById(id);
-
-    return getTasksHtml();
-}
-
-std::string handleSortTasks(const std::string &request)
-{
-    size_t bodyStart = request.find("\r\n\r\n");
-    if (bodyStart == std::string::npos)
-        return get404Page();
-
-    std::string body = request.substr(bodyStart + 4);
-    auto params = parseFormData(body);
-
-    std::string sortBy = params["sortBy"];
-
-    if (sortBy == "priority")
-    {
-        taskManager.sortTasksByPriority();
-    }
-    else if (sortBy == "dueDate")
-    {
-        taskManager.sortTasksByDueDate();
-    }
-    else if (sortBy == "title")
-    {
-        taskManager.sortTasksByTitle();
+        if (!ok)
+        {
+            std::cerr << "Usage: " << argv[0] << " [--actor] [--memory=heap|pool|monotonic] [--reactor[=N]] [--workers[=N]] [--queue-limit=N]"
+                      << " [--keep-alive-timeout=S] [--max-requests=N]" << std::endl;
+            return 1;
+        }
     }
 
-    return getTasksHtml();
-}
-
-std::string get404Page()
-{
-    std::string html = "<h1>404 Not Found</h1>";
-    return "HTTP/1.1 404 Not Found\r\nContent-Type: text/html\r\nContent-Length: " +
-           std::to_string(html.length()) + "\r\n\r\n" + html;
-}
-}
-;
-
-int main()
-{
-    SimpleHttpServer server(8080);
+    SimpleHttpServer server(8080, options);
     server.start();
     return 0;
->>>>>>> 31e08e23f34c54259e619d4f92b64e13a13828aa
 }
\ No newline at end of file